@@ -20,25 +20,22 @@
 #include "EventSearcher6.hpp"
 #include <Core/Parents/EventResult.hpp>
 #include <Core/RNG/MT.hpp>
-#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 #include <Core/Util/Game.hpp>
 #include <Core/Util/PIDType.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
-#include <future>
 
 EventSearcher6::EventSearcher6(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, u8 ivCount,
                                PIDType pidType, const Profile6 &profile, const EventFilter &filter) :
+    Searcher(startTime, endTime, startFrame, endFrame, 0),
     profile(profile),
     filter(filter),
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
     ivCount(ivCount),
-    pidType(pidType),
-    progress(0),
-    searching(false)
+    pidType(pidType)
 {
+    // Gen6 seeds repeat every 2^29 seconds
+    seedPeriod = 0x20000000;
 }
 
 void EventSearcher6::setLocks(bool abilityLocked, u8 ability, bool natureLocked, u8 nature, bool genderLocked, u8 gender)
@@ -70,148 +67,143 @@ void EventSearcher6::setIVTemplate(const std::array<u8, 6> &ivs)
     ivTemplate = ivs;
 }
 
-void EventSearcher6::startSearch(int threads)
+void EventSearcher6::setWondercard(const Wondercard &card)
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime);
-    u64 epochEnd = Utility::getCitraTime(endTime);
+    ivCount = card.getIVCount();
+    pidType = card.getPIDType();
+    setLocks(card.getAbilityLocked(), card.getAbility(), card.getNatureLocked(), card.getNature(), card.getGenderLocked(),
+             card.getGender());
+    setIDs(true, card.getTID(), card.getSID(), card.getOwnID());
+    setHidden(card.getPID(), card.getEC());
+    setIVTemplate(card.getIVTemplate());
+}
 
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
+u32 EventSearcher6::getInitialSeed(u64 epoch) const
+{
+    return static_cast<u32>(profile.getSaveVariable() + profile.getTimeVariable() + epoch);
+}
 
-    if (epochSplit < 1000)
-    {
-        threads = 1;
-    }
+u64 EventSearcher6::getIndexKey() const
+{
+    Hash hash;
+    addConfigHash(hash);
+    filter.addHash(hash);
+    return hash.get();
+}
 
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
-    {
-        if (i == threads - 1)
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
-        }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
-    }
+u64 EventSearcher6::getCacheKey() const
+{
+    Hash hash;
+    addConfigHash(hash);
+    return hash.get();
+}
 
-    for (int i = 0; i < threads; i++)
-    {
-        threadContainer[i].wait();
-    }
+std::unique_ptr<ResultFilter> EventSearcher6::getFilter() const
+{
+    return std::make_unique<EventFilter>(filter);
 }
 
-void EventSearcher6::cancelSearch()
+bool EventSearcher6::compare(const ResultFilter &filter, const EventResult &result) const
 {
-    searching = false;
+    return static_cast<const EventFilter &>(filter).compare(result);
 }
 
-int EventSearcher6::getProgress() const
+void EventSearcher6::addConfigHash(Hash &hash) const
 {
-    return progress;
+    hash.add(std::string("EventSearcher6"));
+    hash.add(ownID ? profile.getTID() : tid).add(ownID ? profile.getSID() : sid).add(otherInfo).add(tid).add(sid).add(profile.getVersion());
+    hash.add(ivCount).add(pidType).add(pid).add(ec).add(ivTemplate);
+    hash.add(abilityLocked).add(ability).add(natureLocked).add(nature).add(genderLocked).add(gender);
 }
 
-int EventSearcher6::getMaxProgress() const
+u64 EventSearcher6::getSeedKey() const
 {
-    auto val = static_cast<int>((Utility::getCitraTime(endTime) - Utility::getCitraTime(startTime)) / 1000);
-    return val + 1;
+    return static_cast<u32>(profile.getSaveVariable() + profile.getTimeVariable());
 }
 
-std::vector<EventResult> EventSearcher6::getResults()
+void EventSearcher6::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<EventResult> &hits)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    auto *searchFilter = static_cast<const EventFilter *>(filter);
+    auto kernel = [&](const u32 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, searchFilter, hits); };
+    RNGWindow<u32, MT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
 }
 
-void EventSearcher6::search(u64 epochStart, u64 epochEnd)
+void EventSearcher6::searchWindow(u32 initialSeed, const u32 *window, u32 frameStart, u32 count, const EventFilter *searchFilter,
+                                  std::vector<EventResult> &hits)
 {
-    u32 save = profile.getSaveVariable();
-    u32 time = profile.getTimeVariable();
+    STAGE_TIMER(Stage::FrameGeneration);
+
+    const EventFilter &active = searchFilter ? *searchFilter : filter;
+
     u16 eventTID = ownID ? profile.getTID() : tid;
     u16 eventSID = ownID ? profile.getSID() : sid;
     u8 counter = (profile.getVersion() & Game::ORAS) ? 2 : 1;
 
-    DateTime target = DateTime(Utility::getNormalTime(epochStart));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 i = 0, frame = frameStart; i < count; i++, frame++)
     {
-        u32 initialSeed = save + time + epoch;
+        WindowList rngList(window + i);
 
-        MT mt(initialSeed, startFrame);
-        RNGList<u32, MT, 128> rngList(mt);
+        EventResult result(initialSeed, eventTID, eventSID);
 
-        for (u32 frame = startFrame; frame <= endFrame; frame++, rngList.advanceState())
+        for (u8 j = 0; j < counter; j++)
         {
-            EventResult result(initialSeed, eventTID, eventSID);
+            result.setEC(ec > 0 ? ec : rngList.getValue());
 
-            for (u8 j = 0; j < counter; j++)
+            switch (pidType)
             {
-                result.setEC(ec > 0 ? ec : rngList.getValue());
-
-                switch (pidType)
+            case PIDType::Random:
+                result.setPID(rngList.getValue());
+                break;
+            case PIDType::Nonshiny:
+                result.setPID(rngList.getValue());
+                if (result.getShiny())
                 {
-                case PIDType::Random:
-                    result.setPID(rngList.getValue());
-                    break;
-                case PIDType::Nonshiny:
-                    result.setPID(rngList.getValue());
-                    if (result.getShiny())
-                    {
-                        result.setPID(result.getPID() ^ 0x10000000);
-                    }
-                    break;
-                case PIDType::Shiny:
-                    result.setPID(rngList.getValue());
-                    if (otherInfo)
-                    {
-                        result.setPID(((tid ^ sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
-                    }
-                    break;
-                case PIDType::Specified:
-                    result.setPID(pid);
-                    break;
+                    result.setPID(result.getPID() ^ 0x10000000);
                 }
-
-                result.setIVs(ivTemplate);
-                for (u8 i = 0; i < ivCount;)
+                break;
+            case PIDType::Shiny:
+                result.setPID(rngList.getValue());
+                if (otherInfo)
                 {
-                    u8 tmp = static_cast<u64>(rngList.getValue()) * 6 >> 32;
-                    if (result.getIV(tmp) == 255)
-                    {
-                        result.setIV(tmp, 31);
-                        i++;
-                    }
+                    result.setPID(((tid ^ sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
                 }
+                break;
+            case PIDType::Specified:
+                result.setPID(pid);
+                break;
+            }
 
-                for (u8 i = 0; i < 6; i++)
+            result.setIVs(ivTemplate);
+            for (u8 i = 0; i < ivCount;)
+            {
+                u8 tmp = static_cast<u64>(rngList.getValue()) * 6 >> 32;
+                if (result.getIV(tmp) == 255)
                 {
-                    if (result.getIV(i) == 255)
-                    {
-                        result.setIV(i, rngList.getValue() >> 27);
-                    }
+                    result.setIV(tmp, 31);
+                    i++;
                 }
-                result.calcHiddenPower();
+            }
 
-                result.setAbility(abilityLocked ? ability : (static_cast<u64>(rngList.getValue()) * (ability + 2) >> 32));
+            for (u8 i = 0; i < 6; i++)
+            {
+                if (result.getIV(i) == 255)
+                {
+                    result.setIV(i, rngList.getValue() >> 27);
+                }
+            }
+            result.calcHiddenPower();
 
-                result.setNature(natureLocked ? nature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
+            result.setAbility(abilityLocked ? ability : (static_cast<u64>(rngList.getValue()) * (ability + 2) >> 32));
 
-                result.setGender(genderLocked ? gender : (static_cast<u64>(rngList.getValue()) * 252 >> 32) < gender);
-            }
+            result.setNature(natureLocked ? nature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
 
-            if (filter.compare(result))
-            {
-                result.setTarget(target);
-                result.setFrame(frame);
+            result.setGender(genderLocked ? gender : (static_cast<u64>(rngList.getValue()) * 252 >> 32) < gender);
+        }
 
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(result);
-            }
+        if (active.compare(result))
+        {
+            result.setFrame(frame);
+            hits.emplace_back(result);
         }
-        progress++;
     }
 }
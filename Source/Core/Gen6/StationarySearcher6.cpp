@@ -20,109 +20,107 @@
 #include "StationarySearcher6.hpp"
 #include <Core/Parents/StationaryResult.hpp>
 #include <Core/RNG/MT.hpp>
-#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/RNGWindow.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
-#include <future>
 
 StationarySearcher6::StationarySearcher6(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, bool ivCount,
                                          u8 ability, u8 synchNature, u8 gender, bool alwaysSynch, bool shinyLocked, const Profile6 &profile,
                                          const StationaryFilter &filter) :
-    profile(profile),
-    filter(filter),
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
-    ivCount(ivCount ? 3 : 0),
-    ability(ability),
-    synchNature(synchNature),
-    pidCount(profile.getShinyCharm() ? 3 : 1),
-    gender(gender),
-    alwaysSynch(alwaysSynch),
-    shinyLocked(shinyLocked),
-    progress(0),
-    searching(false)
+    StationarySearcher6(startTime, endTime, startFrame, endFrame,
+                        { StationaryTarget(ivCount, ability, synchNature, gender, alwaysSynch, shinyLocked, filter) }, profile)
 {
 }
 
-void StationarySearcher6::startSearch(int threads)
+StationarySearcher6::StationarySearcher6(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame,
+                                         const std::vector<StationaryTarget> &targets, const Profile6 &profile) :
+    Searcher(startTime, endTime, startFrame, endFrame, 0),
+    profile(profile),
+    targets(targets),
+    pidCount(profile.getShinyCharm() ? 3 : 1)
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime);
-    u64 epochEnd = Utility::getCitraTime(endTime);
+    // Seeds are save + time + epoch truncated to 32 bits with the epoch stepping by 1000, so they repeat every 2^29 seconds
+    seedPeriod = 0x20000000;
+}
 
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
+u32 StationarySearcher6::getInitialSeed(u64 epoch) const
+{
+    return static_cast<u32>(profile.getSaveVariable() + profile.getTimeVariable() + epoch);
+}
 
-    if (epochSplit < 1000)
+u64 StationarySearcher6::getIndexKey() const
+{
+    Hash hash;
+    hash.add(std::string("StationarySearcher6")).add(profile.getTID()).add(profile.getSID());
+    for (const auto &target : targets)
     {
-        threads = 1;
+        addTargetHash(hash, target);
+        target.filter.addHash(hash);
     }
+    return hash.get();
+}
 
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
+u64 StationarySearcher6::getCacheKey() const
+{
+    // Targets are filtered separately, only single target searches are cached
+    if (targets.size() != 1)
     {
-        if (i == threads - 1)
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
-        }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
+        return 0;
     }
 
-    for (int i = 0; i < threads; i++)
-    {
-        threadContainer[i].wait();
-    }
+    Hash hash;
+    hash.add(std::string("StationarySearcher6")).add(profile.getTID()).add(profile.getSID());
+    addTargetHash(hash, targets.front());
+    return hash.get();
+}
+
+std::unique_ptr<ResultFilter> StationarySearcher6::getFilter() const
+{
+    return std::make_unique<StationaryFilter>(targets.front().filter);
 }
 
-void StationarySearcher6::cancelSearch()
+bool StationarySearcher6::compare(const ResultFilter &filter, const StationaryResult &result) const
 {
-    searching = false;
+    return static_cast<const StationaryFilter &>(filter).compare(result);
 }
 
-int StationarySearcher6::getProgress() const
+void StationarySearcher6::addTargetHash(Hash &hash, const StationaryTarget &target) const
 {
-    return progress;
+    hash.add(target.ivCount).add(target.ability).add(target.synchNature).add(pidCount).add(target.gender);
+    hash.add(target.alwaysSynch).add(target.shinyLocked);
 }
 
-int StationarySearcher6::getMaxProgress() const
+u64 StationarySearcher6::getSeedKey() const
 {
-    auto val = static_cast<int>((Utility::getCitraTime(endTime) - Utility::getCitraTime(startTime)) / 1000);
-    return val + 1;
+    return static_cast<u32>(profile.getSaveVariable() + profile.getTimeVariable());
 }
 
-std::vector<StationaryResult> StationarySearcher6::getResults()
+void StationarySearcher6::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter,
+                                     std::vector<StationaryResult> &hits)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    auto *searchFilter = static_cast<const StationaryFilter *>(filter);
+    auto kernel = [&](const u32 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, searchFilter, hits); };
+    RNGWindow<u32, MT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
 }
 
-void StationarySearcher6::search(u64 epochStart, u64 epochEnd)
+void StationarySearcher6::searchWindow(u32 initialSeed, const u32 *window, u32 frameStart, u32 count, const StationaryFilter *searchFilter,
+                                       std::vector<StationaryResult> &hits)
 {
-    u32 saveVariable = profile.getTimeVariable();
-    u32 timeVariable = profile.getSaveVariable();
+    STAGE_TIMER(Stage::FrameGeneration);
+
     u16 tid = profile.getTID();
     u16 sid = profile.getSID();
 
-    DateTime target = DateTime(Utility::getNormalTime(epochStart));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 i = 0, frame = frameStart; i < count; i++, frame++)
     {
-        u32 initialSeed = static_cast<u32>(saveVariable + epoch + timeVariable);
-
-        MT mt(initialSeed, startFrame);
-        RNGList<u32, MT, 128> rngList(mt);
-
-        for (u32 frame = startFrame; frame <= endFrame; frame++, rngList.advanceState())
+        for (u32 index = 0; index < targets.size(); index++)
         {
+            auto &target = targets[index];
+            WindowList rngList(window + i);
+
             StationaryResult result(initialSeed, tid, sid);
 
-            if (!alwaysSynch)
+            if (!target.alwaysSynch)
             {
                 rngList.advanceFrames(60);
             }
@@ -134,7 +132,7 @@ void StationarySearcher6::search(u64 epochStart, u64 epochEnd)
                 result.setPID(rngList.getValue());
                 if (result.getShiny())
                 {
-                    if (shinyLocked)
+                    if (target.shinyLocked)
                     {
                         result.setPID(result.getPID() ^ 0x10000000);
                     }
@@ -148,7 +146,7 @@ void StationarySearcher6::search(u64 epochStart, u64 epochEnd)
                 }*/
             }
 
-            for (u8 i = 0; i < ivCount;)
+            for (u8 i = 0; i < target.ivCount;)
             {
                 u8 tmp = static_cast<u64>(rngList.getValue()) * 6 >> 32;
                 if (result.getIV(tmp) == 255)
@@ -167,21 +165,19 @@ void StationarySearcher6::search(u64 epochStart, u64 epochEnd)
             }
             result.calcHiddenPower();
 
-            result.setAbility(ability != 255 ? ability : rngList.getValue() >> 31);
+            result.setAbility(target.ability != 255 ? target.ability : rngList.getValue() >> 31);
 
-            result.setNature(alwaysSynch ? synchNature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
+            result.setNature(target.alwaysSynch ? target.synchNature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
 
-            result.setGender((gender > 0 && gender < 254) ? (static_cast<u64>(rngList.getValue()) * 252 >> 32 < gender) : gender);
+            result.setGender((target.gender > 0 && target.gender < 254) ? (static_cast<u64>(rngList.getValue()) * 252 >> 32 < target.gender)
+                                                                        : target.gender);
 
-            if (filter.compare(result))
+            if ((searchFilter ? *searchFilter : target.filter).compare(result))
             {
-                result.setTarget(target);
                 result.setFrame(frame);
-
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(result);
+                result.setEncounter(index);
+                hits.emplace_back(result);
             }
         }
-        progress++;
     }
 }
@@ -21,39 +21,44 @@
 #define STATIONARYSEARCHER6_HPP
 
 #include <Core/Gen6/Profile6.hpp>
+#include <Core/Parents/Searcher.hpp>
 #include <Core/Parents/StationaryFilter.hpp>
-#include <Core/Util/DateTime.hpp>
-#include <atomic>
-#include <mutex>
+#include <Core/Parents/StationaryResult.hpp>
+#include <Core/Parents/StationaryTarget.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 
-class StationaryResult;
-
-class StationarySearcher6
+class StationarySearcher6 : public Searcher<StationaryResult>
 {
 public:
+    using WindowList = RNGWindowList<u32, 128>;
+
     StationarySearcher6(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, bool ivCount, u8 ability,
                         u8 synchNature, u8 gender, bool alwaysSynch, bool shinyLocked, const Profile6 &profile,
                         const StationaryFilter &filter);
-    void startSearch(int threads);
-    void cancelSearch();
-    int getProgress() const;
-    int getMaxProgress() const;
-    std::vector<StationaryResult> getResults();
+
+    // Checks every target on each frame, results are tagged with the index of the target they matched
+    StationarySearcher6(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame,
+                        const std::vector<StationaryTarget> &targets, const Profile6 &profile);
+
+    // Searches count frames from frameStart with the values of a window shared between searches of the same seed.
+    // A search filter replaces each target's own filter when it isn't null.
+    void searchWindow(u32 initialSeed, const u32 *window, u32 frameStart, u32 count, const StationaryFilter *searchFilter,
+                      std::vector<StationaryResult> &hits);
 
 private:
     Profile6 profile;
-    StationaryFilter filter;
-    DateTime startTime, endTime;
-    u32 startFrame, endFrame;
-    u8 ivCount, ability, synchNature, pidCount, gender;
-    bool alwaysSynch, shinyLocked;
-
-    std::vector<StationaryResult> results;
-    std::mutex mutex;
-    std::atomic_int progress;
-    bool searching;
-
-    void search(u64 epochStart, u64 epochEnd);
+    std::vector<StationaryTarget> targets;
+    u8 pidCount;
+
+    u32 getInitialSeed(u64 epoch) const override;
+    u64 getIndexKey() const override;
+    u64 getSeedKey() const override;
+    u64 getCacheKey() const override;
+    std::unique_ptr<ResultFilter> getFilter() const override;
+    bool compare(const ResultFilter &filter, const StationaryResult &result) const override;
+    void addTargetHash(Hash &hash, const StationaryTarget &target) const;
+    void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter,
+                    std::vector<StationaryResult> &hits) override;
 };
 
 #endif // STATIONARYSEARCHER6_HPP
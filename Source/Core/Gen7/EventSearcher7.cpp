@@ -19,24 +19,20 @@
 
 #include "EventSearcher7.hpp"
 #include <Core/Parents/EventResult.hpp>
-#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 #include <Core/RNG/SFMT.hpp>
 #include <Core/Util/PIDType.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
-#include <future>
 
 EventSearcher7::EventSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, u8 ivCount,
                                PIDType pidType, const Profile7 &profile, const EventFilter &filter) :
+    Searcher(startTime, endTime, startFrame, endFrame, profile.getOffset()),
     profile(profile),
+    calendar(SeedCalendar7::find(profile.getTick(), profile.getOffset())),
     filter(filter),
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
     ivCount(ivCount),
-    pidType(pidType),
-    progress(0),
-    searching(false)
+    pidType(pidType)
 {
 }
 
@@ -69,145 +65,151 @@ void EventSearcher7::setIVTemplate(const std::array<u8, 6> &ivs)
     ivTemplate = ivs;
 }
 
-void EventSearcher7::startSearch(int threads)
+void EventSearcher7::setWondercard(const Wondercard &card)
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime, profile.getOffset());
-    u64 epochEnd = Utility::getCitraTime(endTime, profile.getOffset());
+    ivCount = card.getIVCount();
+    pidType = card.getPIDType();
+    setLocks(card.getAbilityLocked(), card.getAbility(), card.getNatureLocked(), card.getNature(), card.getGenderLocked(),
+             card.getGender());
+    setIDs(true, card.getTID(), card.getSID(), card.getOwnID());
+    setHidden(card.getPID(), card.getEC());
+    setIVTemplate(card.getIVTemplate());
+}
 
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
+u32 EventSearcher7::getInitialSeed(u64 epoch) const
+{
+    return calendar ? calendar->getSeed(epoch) : Utility::calcInitialSeed(profile.getTick(), epoch);
+}
 
-    if (epochSplit < 1000)
+void EventSearcher7::getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const
+{
+    if (calendar)
     {
-        threads = 1;
+        calendar->getSeeds(epochs, count, seeds);
     }
-
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
+    else
     {
-        if (i == threads - 1)
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
-        }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
+        Utility::calcInitialSeeds(profile.getTick(), epochs, count, seeds);
     }
+}
 
-    for (int i = 0; i < threads; i++)
-    {
-        threadContainer[i].wait();
-    }
+u64 EventSearcher7::getIndexKey() const
+{
+    Hash hash;
+    addConfigHash(hash);
+    filter.addHash(hash);
+    return hash.get();
+}
+
+u64 EventSearcher7::getCacheKey() const
+{
+    Hash hash;
+    addConfigHash(hash);
+    return hash.get();
+}
+
+std::unique_ptr<ResultFilter> EventSearcher7::getFilter() const
+{
+    return std::make_unique<EventFilter>(filter);
 }
 
-void EventSearcher7::cancelSearch()
+bool EventSearcher7::compare(const ResultFilter &filter, const EventResult &result) const
 {
-    searching = false;
+    return static_cast<const EventFilter &>(filter).compare(result);
 }
 
-int EventSearcher7::getProgress() const
+void EventSearcher7::addConfigHash(Hash &hash) const
 {
-    return progress;
+    hash.add(std::string("EventSearcher7"));
+    hash.add(ownID ? profile.getTID() : tid).add(ownID ? profile.getSID() : sid).add(otherInfo).add(tid).add(sid);
+    hash.add(ivCount).add(pidType).add(pid).add(ec).add(ivTemplate);
+    hash.add(abilityLocked).add(ability).add(natureLocked).add(nature).add(genderLocked).add(gender);
 }
 
-int EventSearcher7::getMaxProgress() const
+u64 EventSearcher7::getSeedKey() const
 {
-    auto val = static_cast<int>(
-        (Utility::getCitraTime(endTime, profile.getOffset()) - Utility::getCitraTime(startTime, profile.getOffset())) / 1000);
-    return val + 1;
+    return profile.getTick();
 }
 
-std::vector<EventResult> EventSearcher7::getResults()
+void EventSearcher7::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<EventResult> &hits)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    auto *searchFilter = static_cast<const EventFilter *>(filter);
+    auto kernel = [&](const u64 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, searchFilter, hits); };
+    RNGWindow<u64, SFMT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
 }
 
-void EventSearcher7::search(u64 epochStart, u64 epochEnd)
+void EventSearcher7::searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const EventFilter *searchFilter,
+                                  std::vector<EventResult> &hits)
 {
-    u32 tick = profile.getTick();
-    u32 offset = profile.getOffset();
+    STAGE_TIMER(Stage::FrameGeneration);
+
+    const EventFilter &active = searchFilter ? *searchFilter : filter;
+
     u16 eventTID = ownID ? profile.getTID() : tid;
     u16 eventSID = ownID ? profile.getSID() : sid;
 
-    DateTime target = DateTime(Utility::getNormalTime(epochStart, offset));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 i = 0, frame = frameStart; i < count; i++, frame++)
     {
-        u32 initialSeed = Utility::calcInitialSeed(tick, epoch);
+        WindowList rngList(window + i);
 
-        SFMT sfmt(initialSeed, startFrame);
-        RNGList<u64, SFMT, 64> rngList(sfmt);
+        EventResult result(initialSeed, eventTID, eventSID);
 
-        for (u32 frame = startFrame; frame <= endFrame; frame++, rngList.advanceState())
-        {
-            EventResult result(initialSeed, eventTID, eventSID);
+        result.setEC(ec > 0 ? ec : rngList.getValue() & 0xFFFFFFFF);
 
-            result.setEC(ec > 0 ? ec : rngList.getValue() & 0xFFFFFFFF);
-
-            switch (pidType)
+        switch (pidType)
+        {
+        case PIDType::Random:
+            result.setPID(rngList.getValue() & 0xFFFFFFFF);
+            break;
+        case PIDType::Nonshiny:
+            result.setPID(rngList.getValue() & 0xFFFFFFFF);
+            if (result.getShiny())
             {
-            case PIDType::Random:
-                result.setPID(rngList.getValue() & 0xFFFFFFFF);
-                break;
-            case PIDType::Nonshiny:
-                result.setPID(rngList.getValue() & 0xFFFFFFFF);
-                if (result.getShiny())
-                {
-                    result.setPID(result.getPID() ^ 0x10000000);
-                }
-                break;
-            case PIDType::Shiny:
-                result.setPID(rngList.getValue() & 0xFFFFFFFF);
-                if (otherInfo)
-                {
-                    result.setPID(((tid ^ sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
-                }
-                break;
-            case PIDType::Specified:
-                result.setPID(pid);
-                break;
+                result.setPID(result.getPID() ^ 0x10000000);
             }
-
-            result.setIVs(ivTemplate);
-            for (u8 i = 0; i < ivCount;)
+            break;
+        case PIDType::Shiny:
+            result.setPID(rngList.getValue() & 0xFFFFFFFF);
+            if (otherInfo)
             {
-                u8 tmp = rngList.getValue() % 6;
-                if (result.getIV(tmp) == 255)
-                {
-                    result.setIV(tmp, 31);
-                    i++;
-                }
+                result.setPID(((tid ^ sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
             }
+            break;
+        case PIDType::Specified:
+            result.setPID(pid);
+            break;
+        }
 
-            for (u8 i = 0; i < 6; i++)
+        result.setIVs(ivTemplate);
+        for (u8 i = 0; i < ivCount;)
+        {
+            u8 tmp = rngList.getValue() % 6;
+            if (result.getIV(tmp) == 255)
             {
-                if (result.getIV(i) == 255)
-                {
-                    result.setIV(i, rngList.getValue() & 0x1F);
-                }
+                result.setIV(tmp, 31);
+                i++;
             }
-            result.calcHiddenPower();
+        }
 
-            result.setAbility(abilityLocked ? ability : ability == 0 ? rngList.getValue() & 1 : rngList.getValue() % 3);
+        for (u8 i = 0; i < 6; i++)
+        {
+            if (result.getIV(i) == 255)
+            {
+                result.setIV(i, rngList.getValue() & 0x1F);
+            }
+        }
+        result.calcHiddenPower();
 
-            result.setNature(natureLocked ? nature : rngList.getValue() % 25);
+        result.setAbility(abilityLocked ? ability : ability == 0 ? rngList.getValue() & 1 : rngList.getValue() % 3);
 
-            result.setGender(genderLocked ? gender : (rngList.getValue() % 252) < gender);
+        result.setNature(natureLocked ? nature : rngList.getValue() % 25);
 
-            if (filter.compare(result))
-            {
-                result.setTarget(target);
-                result.setFrame(frame);
+        result.setGender(genderLocked ? gender : (rngList.getValue() % 252) < gender);
 
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(result);
-            }
+        if (active.compare(result))
+        {
+            result.setFrame(frame);
+            hits.emplace_back(result);
         }
-        progress++;
     }
 }
@@ -21,34 +21,39 @@
 #define EVENTSEARCHER7_HPP
 
 #include <Core/Gen7/Profile7.hpp>
+#include <Core/Gen7/SeedCalendar7.hpp>
 #include <Core/Parents/EventFilter.hpp>
-#include <Core/Util/DateTime.hpp>
-#include <atomic>
-#include <mutex>
+#include <Core/Parents/EventResult.hpp>
+#include <Core/Parents/Searcher.hpp>
+#include <Core/Parents/Wondercard.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 
-class EventResult;
 enum PIDType : int;
 
-class EventSearcher7
+class EventSearcher7 : public Searcher<EventResult>
 {
 public:
+    using WindowList = RNGWindowList<u64, 64>;
+
     EventSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, u8 ivCount, PIDType pidType,
                    const Profile7 &profile, const EventFilter &filter);
+
+    // Searches count frames from frameStart with the values of a window shared between searches of the same seed.
+    // A search filter replaces the searcher's own filter when it isn't null.
+    void searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const EventFilter *searchFilter,
+                      std::vector<EventResult> &hits);
     void setLocks(bool abilityLocked, u8 ability, bool natureLocked, u8 nature, bool genderLocked, u8 gender);
     void setIDs(bool checkInfo, u16 tid, u16 sid, bool ownID);
     void setHidden(u32 pid, u32 ec);
     void setIVTemplate(const std::array<u8, 6> &ivs);
-    void startSearch(int threads);
-    void cancelSearch();
-    int getProgress() const;
-    int getMaxProgress() const;
-    std::vector<EventResult> getResults();
+
+    // Takes the IV count, PID type, locks, IDs and IV template of the card instead of the constructor and setters
+    void setWondercard(const Wondercard &card);
 
 private:
     Profile7 profile;
+    std::shared_ptr<SeedCalendar7> calendar;
     EventFilter filter;
-    DateTime startTime, endTime;
-    u32 startFrame, endFrame;
     u8 ivCount, ability, nature, gender;
     bool otherInfo, abilityLocked, natureLocked, genderLocked, ownID;
     PIDType pidType;
@@ -56,12 +61,17 @@ private:
     u16 tid, sid;
     std::array<u8, 6> ivTemplate;
 
-    std::vector<EventResult> results;
-    std::mutex mutex;
-    std::atomic_int progress;
-    bool searching;
+    u32 getInitialSeed(u64 epoch) const override;
+    void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const override;
+    u64 getIndexKey() const override;
+    u64 getSeedKey() const override;
+    u64 getCacheKey() const override;
+    std::unique_ptr<ResultFilter> getFilter() const override;
+    bool compare(const ResultFilter &filter, const EventResult &result) const override;
 
-    void search(u64 epochStart, u64 epochEnd);
+    // Hashes everything besides the filter that decides which frames are hits
+    void addConfigHash(Hash &hash) const;
+    void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<EventResult> &hits) override;
 };
 
 #endif // EVENTSEARCHER7_HPP
@@ -18,106 +18,116 @@
  */
 
 #include "IDSearcher7.hpp"
+#include <Core/RNG/RNGWindow.hpp>
 #include <Core/RNG/SFMT.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
 #include <Core/Parents/IDResult.hpp>
-#include <future>
+#include <algorithm>
 
 IDSearcher7::IDSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, const Profile7 &profile,
                          const IDFilter &filter) :
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
+    Searcher(startTime, endTime, startFrame, endFrame, profile.getOffset()),
     filter(filter),
     profile(profile),
-    progress(0),
-    searching(false)
+    calendar(SeedCalendar7::find(profile.getTick(), profile.getOffset()))
 {
 }
 
-void IDSearcher7::startSearch(int threads)
+void IDSearcher7::setTargetPIDs(const std::vector<u32> &pids)
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime, profile.getOffset());
-    u64 epochEnd = Utility::getCitraTime(endTime, profile.getOffset());
-
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
-
-    if (epochSplit < 1000)
+    tsvCoverage.clear();
+    if (!pids.empty())
     {
-        threads = 1;
-    }
-
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
-    {
-        if (i == threads - 1)
+        // A PID is shiny for exactly one TSV, count how many targets each TSV covers
+        tsvCoverage.resize(0x1000, 0);
+        for (u32 pid : pids)
         {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
+            u16 psv = ((pid >> 16) ^ (pid & 0xffff)) >> 4;
+            tsvCoverage[psv]++;
         }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
     }
+}
 
-    for (int i = 0; i < threads; i++)
-    {
-        threadContainer[i].wait();
-    }
+u32 IDSearcher7::getInitialSeed(u64 epoch) const
+{
+    return calendar ? calendar->getSeed(epoch) : Utility::calcInitialSeed(profile.getTick(), epoch);
 }
 
-void IDSearcher7::cancelSearch()
+void IDSearcher7::getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const
 {
-    searching = false;
+    if (calendar)
+    {
+        calendar->getSeeds(epochs, count, seeds);
+    }
+    else
+    {
+        Utility::calcInitialSeeds(profile.getTick(), epochs, count, seeds);
+    }
 }
 
-int IDSearcher7::getProgress() const
+u64 IDSearcher7::getIndexKey() const
 {
-    return progress;
+    Hash hash;
+    hash.add(std::string("IDSearcher7")).add(tsvCoverage);
+    filter.addHash(hash);
+    return hash.get();
 }
 
-int IDSearcher7::getMaxProgress() const
+u64 IDSearcher7::getSeedKey() const
 {
-    auto val = static_cast<int>(
-        (Utility::getCitraTime(endTime, profile.getOffset()) - Utility::getCitraTime(startTime, profile.getOffset())) / 1000);
-    return val + 1;
+    return profile.getTick();
 }
 
-std::vector<IDResult> IDSearcher7::getResults()
+// ID searches have no result cache, so there is never a search filter
+void IDSearcher7::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *, std::vector<IDResult> &hits)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    auto kernel = [&](const u64 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, nullptr, hits); };
+    RNGWindow<u64, SFMT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
 }
 
-void IDSearcher7::search(u64 epochStart, u64 epochEnd)
+void IDSearcher7::searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const IDFilter *searchFilter,
+                               std::vector<IDResult> &hits)
 {
-    u32 tick = profile.getTick();
-    u32 offset = profile.getOffset();
+    STAGE_TIMER(Stage::FrameGeneration);
+
+    const IDFilter &active = searchFilter ? *searchFilter : filter;
+
+    bool checkPIDs = !tsvCoverage.empty();
+
+    // Frames are handled in batches so the ID math runs over plain arrays the compiler can vectorize
+    constexpr u32 batchSize = 64;
+    u32 rands[batchSize];
+    u32 displayTIDs[batchSize];
+    u16 tids[batchSize];
+    u16 sids[batchSize];
+    u16 tsvs[batchSize];
 
-    DateTime target = DateTime(Utility::getNormalTime(epochStart, offset));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 batch = 0; batch < count; batch += batchSize)
     {
-        u32 initialSeed = Utility::calcInitialSeed(tick, epoch);
+        u32 size = std::min(batchSize, count - batch);
 
-        SFMT sfmt(initialSeed, startFrame);
+        for (u32 i = 0; i < size; i++)
+        {
+            rands[i] = window[batch + i] & 0xffffffff;
+        }
 
-        for (u32 frame = startFrame; frame <= endFrame; frame++)
+        for (u32 i = 0; i < size; i++)
         {
-            IDResult id(initialSeed, frame, sfmt.next() & 0xffffffff);
-            if (filter.compare(id))
-            {
-                id.setTarget(target);
+            displayTIDs[i] = rands[i] % 1000000;
+            tids[i] = rands[i] & 0xffff;
+            sids[i] = rands[i] >> 16;
+            tsvs[i] = (tids[i] ^ sids[i]) >> 4;
+        }
 
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(id);
+        for (u32 i = 0; i < size; i++)
+        {
+            if (active.compare(tids[i], sids[i], tsvs[i], displayTIDs[i]) && (!checkPIDs || tsvCoverage[tsvs[i]] > 0))
+            {
+                IDResult id(initialSeed, frameStart + batch + i, rands[i]);
+                id.setShinyCount(checkPIDs ? tsvCoverage[tsvs[i]] : 0);
+                hits.emplace_back(id);
             }
         }
-        progress++;
     }
 }
@@ -21,36 +21,38 @@
 #define IDSEARCHER7_HPP
 
 #include <Core/Gen7/Profile7.hpp>
+#include <Core/Gen7/SeedCalendar7.hpp>
 #include <Core/Parents/IDFilter.hpp>
-#include <atomic>
-#include <mutex>
-#include <Core/Util/DateTime.hpp>
+#include <Core/Parents/IDResult.hpp>
+#include <Core/Parents/Searcher.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 
-class IDResult;
-
-class IDSearcher7
+class IDSearcher7 : public Searcher<IDResult>
 {
 public:
+    using WindowList = RNGWindowList<u64, 1>;
+
     IDSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, const Profile7 &profile,
                 const IDFilter &filter);
-    void startSearch(int threads);
-    void cancelSearch();
-    int getProgress() const;
-    int getMaxProgress() const;
-    std::vector<IDResult> getResults();
+
+    // Searches count frames from frameStart with the values of a window shared between searches of the same seed.
+    // A search filter replaces the searcher's own filter when it isn't null.
+    void searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const IDFilter *searchFilter,
+                      std::vector<IDResult> &hits);
+
+    void setTargetPIDs(const std::vector<u32> &pids);
 
 private:
-    DateTime startTime, endTime;
-    u32 startFrame, endFrame;
     IDFilter filter;
     Profile7 profile;
-
-    std::vector<IDResult> results;
-    std::mutex mutex;
-    std::atomic_int progress;
-    bool searching;
-
-    void search(u64 epochStart, u64 epochEnd);
+    std::shared_ptr<SeedCalendar7> calendar;
+    std::vector<u16> tsvCoverage;
+
+    u32 getInitialSeed(u64 epoch) const override;
+    void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const override;
+    u64 getIndexKey() const override;
+    u64 getSeedKey() const override;
+    void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<IDResult> &hits) override;
 };
 
 #endif // IDSEARCHER7_HPP
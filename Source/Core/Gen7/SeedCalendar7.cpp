@@ -0,0 +1,227 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SeedCalendar7.hpp"
+#include <Core/Util/Utility.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <vector>
+
+constexpr char magic[8] = { '3', 'D', 'S', 'T', 'F', 'C', 'A', 'L' };
+constexpr u32 version = 1;
+constexpr u64 headerSize = 64;
+
+struct SeedCalendarHeader
+{
+    char magic[8];
+    u32 version;
+    u32 tick;
+    u32 offset;
+    u32 firstDay;
+    u32 days;
+    u32 reserved;
+};
+
+namespace
+{
+    std::mutex registryMutex;
+    std::map<u64, std::weak_ptr<SeedCalendar7>> registry;
+
+    u64 getSeedsOffset(u32 days)
+    {
+        // Keep the seeds page aligned after the header and built flags
+        return (headerSize + days + 4095) & ~4095ull;
+    }
+}
+
+SeedCalendar7::SeedCalendar7(u32 tick, u32 offset) :
+    built(nullptr), seeds(nullptr), tick(tick), offset(offset), firstDay(0), days(0)
+{
+}
+
+std::shared_ptr<SeedCalendar7> SeedCalendar7::open(const std::string &directory, u32 tick, u32 offset, const Date &start, u32 days)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // The file can't be recreated while another calendar still maps it, keep using that one
+    u64 key = (static_cast<u64>(tick) << 32) | offset;
+    if (auto calendar = registry[key].lock())
+    {
+        return calendar;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%08x_%u.cal", tick, offset);
+
+    auto calendar = std::make_shared<SeedCalendar7>(tick, offset);
+    if (!calendar->load((std::filesystem::path(directory) / name).string(), start, days))
+    {
+        return nullptr;
+    }
+
+    registry[key] = calendar;
+    return calendar;
+}
+
+std::shared_ptr<SeedCalendar7> SeedCalendar7::find(u32 tick, u32 offset)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    auto it = registry.find((static_cast<u64>(tick) << 32) | offset);
+    return it == registry.end() ? nullptr : it->second.lock();
+}
+
+bool SeedCalendar7::buildNextDay()
+{
+    std::lock_guard<std::mutex> lock(buildMutex);
+
+    for (u32 day = 0; seeds && day < days; day++)
+    {
+        if (!std::atomic_ref<u8>(built[day]).load(std::memory_order_acquire))
+        {
+            buildDay(day);
+            return true;
+        }
+    }
+    return false;
+}
+
+u32 SeedCalendar7::getBuiltDays() const
+{
+    u32 count = 0;
+    for (u32 day = 0; day < days; day++)
+    {
+        count += std::atomic_ref<u8>(built[day]).load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+u32 SeedCalendar7::getDays() const
+{
+    return days;
+}
+
+u32 SeedCalendar7::getSeed(u64 epoch) const
+{
+    u32 seed;
+    return lookup(epoch, seed) ? seed : Utility::calcInitialSeed(tick, epoch);
+}
+
+void SeedCalendar7::getSeeds(const u64 *epochs, u32 count, u32 *seeds) const
+{
+    // Epochs missing from the calendar are gathered so they can still be hashed as a batch
+    std::vector<u64> missingEpochs;
+    std::vector<u32> missingIndexes;
+    for (u32 i = 0; i < count; i++)
+    {
+        if (!lookup(epochs[i], seeds[i]))
+        {
+            missingEpochs.emplace_back(epochs[i]);
+            missingIndexes.emplace_back(i);
+        }
+    }
+
+    if (!missingEpochs.empty())
+    {
+        std::vector<u32> missingSeeds(missingEpochs.size());
+        Utility::calcInitialSeeds(tick, missingEpochs.data(), static_cast<u32>(missingEpochs.size()), missingSeeds.data());
+        for (size_t i = 0; i < missingIndexes.size(); i++)
+        {
+            seeds[missingIndexes[i]] = missingSeeds[i];
+        }
+    }
+}
+
+bool SeedCalendar7::lookup(u64 epoch, u32 &seed) const
+{
+    u64 time = epoch - offset;
+    if (epoch < offset || time % 1000 != 0)
+    {
+        return false;
+    }
+
+    // Seconds before the first day wrap around and fail the range check
+    u64 second = time / 1000;
+    u64 day = second / 86400 - firstDay;
+    if (day >= days || !std::atomic_ref<u8>(built[day]).load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    seed = seeds[second - firstDay * 86400ull];
+    return true;
+}
+
+bool SeedCalendar7::load(const std::string &path, const Date &start, u32 days)
+{
+    u32 firstDay = Date().daysTo(start);
+    u64 seedsOffset = getSeedsOffset(days);
+    u64 size = seedsOffset + static_cast<u64>(days) * 86400 * sizeof(u32);
+
+    SeedCalendarHeader header;
+    bool valid = file.open(path, true) && file.getSize() == size;
+    if (valid)
+    {
+        std::memcpy(&header, file.getData(), sizeof(header));
+        valid = std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == version && header.tick == tick
+            && header.offset == offset && header.firstDay == firstDay && header.days == days;
+    }
+
+    if (!valid)
+    {
+        if (!file.create(path, size))
+        {
+            return false;
+        }
+
+        header = {};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.tick = tick;
+        header.offset = offset;
+        header.firstDay = firstDay;
+        header.days = days;
+        std::memcpy(file.getData(), &header, sizeof(header));
+    }
+
+    this->firstDay = firstDay;
+    this->days = days;
+    built = file.getData() + headerSize;
+    seeds = reinterpret_cast<u32 *>(file.getData() + seedsOffset);
+    return true;
+}
+
+void SeedCalendar7::buildDay(u32 day)
+{
+    u32 *daySeeds = seeds + static_cast<u64>(day) * 86400;
+    u64 epoch = (static_cast<u64>(firstDay) + day) * 86400000 + offset;
+    for (u32 second = 0; second < 86400; second++, epoch += 1000)
+    {
+        daySeeds[second] = Utility::calcInitialSeed(tick, epoch);
+    }
+
+    // Seeds have to be visible before the day is marked as built
+    std::atomic_ref<u8>(built[day]).store(1, std::memory_order_release);
+}
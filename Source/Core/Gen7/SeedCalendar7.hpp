@@ -0,0 +1,68 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEEDCALENDAR7_HPP
+#define SEEDCALENDAR7_HPP
+
+#include <Core/Util/DateTime.hpp>
+#include <Core/Util/MappedFile.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// Memory mapped file holding the initial seed of every second of a span of days for one (tick, offset) pair.
+// Days are filled by whoever calls buildNextDay() and looked up by the Gen7 searchers instead of hashing.
+class SeedCalendar7
+{
+public:
+    SeedCalendar7(u32 tick, u32 offset);
+    SeedCalendar7(const SeedCalendar7 &) = delete;
+    void operator=(const SeedCalendar7 &) = delete;
+
+    // Opens the calendar for the tick and offset in the directory, recreating it if it covers a different span.
+    // The calendar is registered so searchers for the same tick and offset find it while it is alive.
+    static std::shared_ptr<SeedCalendar7> open(const std::string &directory, u32 tick, u32 offset, const Date &start, u32 days);
+
+    // Calendar currently open for the tick and offset, nullptr if there is none
+    static std::shared_ptr<SeedCalendar7> find(u32 tick, u32 offset);
+
+    // Builds the first day that isn't built yet, returns false once every day is built. Builders of the same calendar
+    // take turns so a day is only ever written by one of them.
+    bool buildNextDay();
+    u32 getBuiltDays() const;
+    u32 getDays() const;
+
+    // Falls back to hashing for epochs outside of the built days or not on the profile offset
+    u32 getSeed(u64 epoch) const;
+    void getSeeds(const u64 *epochs, u32 count, u32 *seeds) const;
+
+private:
+    MappedFile file;
+    std::mutex buildMutex;
+    u8 *built;
+    u32 *seeds;
+    u32 tick, offset;
+    u32 firstDay, days;
+
+    bool lookup(u64 epoch, u32 &seed) const;
+    bool load(const std::string &path, const Date &start, u32 days);
+    void buildDay(u32 day);
+};
+
+#endif // SEEDCALENDAR7_HPP
@@ -0,0 +1,160 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SeedDateFinder7.hpp"
+#include <Core/Util/Utility.hpp>
+#include <algorithm>
+#include <bit>
+#include <future>
+
+SeedDateFinder7::SeedDateFinder7(const DateTime &startTime, const DateTime &endTime, const Profile7 &profile,
+                                 const std::vector<u32> &wantedSeeds) :
+    epochStart(Utility::getCitraTime(startTime, profile.getOffset())),
+    epochEnd(Utility::getCitraTime(endTime, profile.getOffset())),
+    tick(profile.getTick()),
+    offset(profile.getOffset()),
+    wantedSeeds(wantedSeeds)
+{
+    std::sort(this->wantedSeeds.begin(), this->wantedSeeds.end());
+    this->wantedSeeds.erase(std::unique(this->wantedSeeds.begin(), this->wantedSeeds.end()), this->wantedSeeds.end());
+
+    // Around 16 bits per wanted seed keeps false positives near 1 in 16 while the filter stays small enough to cache
+    u64 filterBits = std::clamp<u64>(std::bit_ceil(std::max<u64>(this->wantedSeeds.size(), 1)) * 16, 0x10000, 0x100000000);
+    filterMask = filterBits - 1;
+    filter.resize(filterBits / 64, 0);
+    for (u32 seed : this->wantedSeeds)
+    {
+        filter[(seed & filterMask) >> 6] |= 1ull << (seed & 63);
+    }
+
+    if (filterBits == 0x100000000)
+    {
+        this->wantedSeeds.clear();
+        this->wantedSeeds.shrink_to_fit();
+    }
+}
+
+void SeedDateFinder7::startSearch(int threads)
+{
+    for (auto &counter : counters)
+    {
+        counter.reset();
+    }
+    control.start();
+
+    constexpr u64 chunkSeconds = 3600;
+
+    // Chunks of an hour are handed out in order to whichever thread is free
+    std::atomic<u64> next = epochStart;
+
+    std::vector<std::future<void>> threadContainer;
+    for (int i = 0; i < threads; i++)
+    {
+        threadContainer.emplace_back(std::async(std::launch::async, [this, &next, i] {
+            SearchCounters &counter = counters[i % counters.size()];
+            for (u64 start = next.fetch_add(chunkSeconds * 1000); start <= epochEnd && control.poll();
+                 start = next.fetch_add(chunkSeconds * 1000))
+            {
+                search(start, std::min(start + (chunkSeconds - 1) * 1000, epochEnd), counter);
+            }
+        }));
+    }
+
+    for (int i = 0; i < threads; i++)
+    {
+        threadContainer[i].wait();
+    }
+}
+
+void SeedDateFinder7::cancelSearch()
+{
+    control.cancel();
+}
+
+void SeedDateFinder7::pauseSearch()
+{
+    control.pause();
+}
+
+void SeedDateFinder7::resumeSearch()
+{
+    control.resume();
+}
+
+u64 SeedDateFinder7::getProgress() const
+{
+    u64 progress = 0;
+    for (const auto &counter : counters)
+    {
+        progress += counter.progress.load(std::memory_order_relaxed);
+    }
+    return progress;
+}
+
+u64 SeedDateFinder7::getMaxProgress() const
+{
+    return (epochEnd - epochStart) / 1000 + 1;
+}
+
+std::vector<std::pair<DateTime, u32>> SeedDateFinder7::getResults()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto data = std::move(results);
+    return data;
+}
+
+void SeedDateFinder7::search(u64 start, u64 end, SearchCounters &counter)
+{
+    constexpr u32 batchSize = 256;
+    u64 epochs[batchSize];
+    u32 seeds[batchSize];
+    u8 candidates[batchSize];
+
+    for (u64 epoch = start; epoch <= end && control.poll();)
+    {
+        u32 count = 0;
+        for (; count < batchSize && epoch <= end; count++, epoch += 1000)
+        {
+            epochs[count] = epoch;
+        }
+
+        Utility::calcInitialSeeds(tick, epochs, count, seeds);
+
+        // The filter is probed for the whole batch without branches, only the few candidates are confirmed below
+        for (u32 i = 0; i < count; i++)
+        {
+            candidates[i] = (filter[(seeds[i] & filterMask) >> 6] >> (seeds[i] & 63)) & 1;
+        }
+
+        u64 hits = 0;
+        for (u32 i = 0; i < count; i++)
+        {
+            if (candidates[i] && (wantedSeeds.empty() || std::binary_search(wantedSeeds.begin(), wantedSeeds.end(), seeds[i])))
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                results.emplace_back(DateTime(Utility::getNormalTime(epochs[i], offset)), seeds[i]);
+                hits++;
+            }
+        }
+
+        counter.progress.fetch_add(count, std::memory_order_relaxed);
+        counter.seeds.fetch_add(count, std::memory_order_relaxed);
+        counter.hits.fetch_add(hits, std::memory_order_relaxed);
+    }
+}
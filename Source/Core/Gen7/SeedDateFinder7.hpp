@@ -0,0 +1,64 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEEDDATEFINDER7_HPP
+#define SEEDDATEFINDER7_HPP
+
+#include <Core/Gen7/Profile7.hpp>
+#include <Core/Parents/SearchStats.hpp>
+#include <Core/Util/DateTime.hpp>
+#include <Core/Util/SearchControl.hpp>
+#include <array>
+#include <mutex>
+#include <vector>
+
+// Finds every second in a date range whose initial seed is in a set of wanted seeds
+class SeedDateFinder7
+{
+public:
+    SeedDateFinder7(const DateTime &startTime, const DateTime &endTime, const Profile7 &profile, const std::vector<u32> &wantedSeeds);
+    void startSearch(int threads);
+    void cancelSearch();
+    void pauseSearch();
+    void resumeSearch();
+    u64 getProgress() const;
+    u64 getMaxProgress() const;
+    std::vector<std::pair<DateTime, u32>> getResults();
+
+private:
+    u64 epochStart, epochEnd;
+    u32 tick, offset;
+
+    // Bit filter indexed by the low bits of a seed, it is exact once it covers all 32 bits.
+    // Otherwise filter hits are confirmed against the sorted wanted seeds.
+    std::vector<u64> filter;
+    u64 filterMask;
+    std::vector<u32> wantedSeeds;
+
+    std::vector<std::pair<DateTime, u32>> results;
+    std::mutex mutex;
+    SearchControl control;
+
+    // Workers beyond the number of counters share them, the counters stay correct but may contend
+    std::array<SearchCounters, 64> counters;
+
+    void search(u64 start, u64 end, SearchCounters &counter);
+};
+
+#endif // SEEDDATEFINDER7_HPP
@@ -19,108 +19,116 @@
 
 #include "StationarySearcher7.hpp"
 #include <Core/Parents/StationaryResult.hpp>
-#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 #include <Core/RNG/SFMT.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
-#include <future>
 
 StationarySearcher7::StationarySearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, bool ivCount,
                                          u8 ability, u8 synchNature, u8 gender, bool alwaysSynch, bool shinyLocked, const Profile7 &profile,
                                          const StationaryFilter &filter) :
-    profile(profile),
-    filter(filter),
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
-    ivCount(ivCount ? 3 : 0),
-    ability(ability),
-    synchNature(synchNature),
-    pidCount(profile.getShinyCharm() ? 3 : 1),
-    gender(gender),
-    alwaysSynch(alwaysSynch),
-    shinyLocked(shinyLocked),
-    progress(0),
-    searching(false)
+    StationarySearcher7(startTime, endTime, startFrame, endFrame,
+                        { StationaryTarget(ivCount, ability, synchNature, gender, alwaysSynch, shinyLocked, filter) }, profile)
 {
 }
 
-void StationarySearcher7::startSearch(int threads)
+StationarySearcher7::StationarySearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame,
+                                         const std::vector<StationaryTarget> &targets, const Profile7 &profile) :
+    Searcher(startTime, endTime, startFrame, endFrame, profile.getOffset()),
+    profile(profile),
+    calendar(SeedCalendar7::find(profile.getTick(), profile.getOffset())),
+    targets(targets),
+    pidCount(profile.getShinyCharm() ? 3 : 1)
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime, profile.getOffset());
-    u64 epochEnd = Utility::getCitraTime(endTime, profile.getOffset());
+}
 
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
+u32 StationarySearcher7::getInitialSeed(u64 epoch) const
+{
+    return calendar ? calendar->getSeed(epoch) : Utility::calcInitialSeed(profile.getTick(), epoch);
+}
 
-    if (epochSplit < 1000)
+void StationarySearcher7::getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const
+{
+    if (calendar)
     {
-        threads = 1;
+        calendar->getSeeds(epochs, count, seeds);
     }
+    else
+    {
+        Utility::calcInitialSeeds(profile.getTick(), epochs, count, seeds);
+    }
+}
 
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
+u64 StationarySearcher7::getIndexKey() const
+{
+    Hash hash;
+    hash.add(std::string("StationarySearcher7")).add(profile.getTID()).add(profile.getSID());
+    for (const auto &target : targets)
     {
-        if (i == threads - 1)
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
-        }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
+        addTargetHash(hash, target);
+        target.filter.addHash(hash);
     }
+    return hash.get();
+}
 
-    for (int i = 0; i < threads; i++)
+u64 StationarySearcher7::getCacheKey() const
+{
+    // Targets are filtered separately, only single target searches are cached
+    if (targets.size() != 1)
     {
-        threadContainer[i].wait();
+        return 0;
     }
+
+    Hash hash;
+    hash.add(std::string("StationarySearcher7")).add(profile.getTID()).add(profile.getSID());
+    addTargetHash(hash, targets.front());
+    return hash.get();
 }
 
-void StationarySearcher7::cancelSearch()
+std::unique_ptr<ResultFilter> StationarySearcher7::getFilter() const
 {
-    searching = false;
+    return std::make_unique<StationaryFilter>(targets.front().filter);
 }
 
-int StationarySearcher7::getProgress() const
+bool StationarySearcher7::compare(const ResultFilter &filter, const StationaryResult &result) const
 {
-    return progress;
+    return static_cast<const StationaryFilter &>(filter).compare(result);
 }
 
-int StationarySearcher7::getMaxProgress() const
+void StationarySearcher7::addTargetHash(Hash &hash, const StationaryTarget &target) const
 {
-    auto val = static_cast<int>(
-        (Utility::getCitraTime(endTime, profile.getOffset()) - Utility::getCitraTime(startTime, profile.getOffset())) / 1000);
-    return val + 1;
+    hash.add(target.ivCount).add(target.ability).add(target.synchNature).add(pidCount).add(target.gender);
+    hash.add(target.alwaysSynch).add(target.shinyLocked);
 }
 
-std::vector<StationaryResult> StationarySearcher7::getResults()
+u64 StationarySearcher7::getSeedKey() const
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    return profile.getTick();
 }
 
-void StationarySearcher7::search(u64 epochStart, u64 epochEnd)
+void StationarySearcher7::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter,
+                                     std::vector<StationaryResult> &hits)
 {
-    u32 tick = profile.getTick();
-    u32 offset = profile.getOffset();
+    auto *searchFilter = static_cast<const StationaryFilter *>(filter);
+    auto kernel = [&](const u64 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, searchFilter, hits); };
+    RNGWindow<u64, SFMT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
+}
+
+void StationarySearcher7::searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const StationaryFilter *searchFilter,
+                                       std::vector<StationaryResult> &hits)
+{
+    STAGE_TIMER(Stage::FrameGeneration);
+
     u16 tid = profile.getTID();
     u16 sid = profile.getSID();
 
-    DateTime target(Utility::getNormalTime(epochStart, offset));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 i = 0, frame = frameStart; i < count; i++, frame++)
     {
-        u32 initialSeed = Utility::calcInitialSeed(tick, epoch);
-
-        SFMT sfmt(initialSeed, startFrame);
-        RNGList<u64, SFMT, 64> rngList(sfmt);
-
-        for (u32 frame = startFrame; frame <= endFrame; frame++, rngList.advanceState())
+        for (u32 index = 0; index < targets.size(); index++)
         {
+            auto &target = targets[index];
+            WindowList rngList(window + i);
+
             StationaryResult result(initialSeed, tid, sid);
 
             // TODO
@@ -141,7 +149,7 @@ void StationarySearcher7::search(u64 epochStart, u64 epochEnd)
                 result.setPID(rngList.getValue() & 0xffffffff);
                 if (result.getShiny())
                 {
-                    if (shinyLocked)
+                    if (target.shinyLocked)
                     {
                         result.setPID(result.getPID() ^ 0x10000000);
                     }
@@ -155,7 +163,7 @@ void StationarySearcher7::search(u64 epochStart, u64 epochEnd)
                 }*/
             }
 
-            for (u8 i = 0; i < ivCount;)
+            for (u8 i = 0; i < target.ivCount;)
             {
                 u8 tmp = rngList.getValue() % 6;
                 if (result.getIV(tmp) == 255)
@@ -174,21 +182,18 @@ void StationarySearcher7::search(u64 epochStart, u64 epochEnd)
             }
             result.calcHiddenPower();
 
-            result.setAbility(ability != 255 ? ability : rngList.getValue() & 1);
+            result.setAbility(target.ability != 255 ? target.ability : rngList.getValue() & 1);
 
-            result.setNature(alwaysSynch ? synchNature : rngList.getValue() % 25);
+            result.setNature(target.alwaysSynch ? target.synchNature : rngList.getValue() % 25);
 
-            result.setGender((gender > 0 && gender < 254) ? (rngList.getValue() % 252 < gender) : gender);
+            result.setGender((target.gender > 0 && target.gender < 254) ? (rngList.getValue() % 252 < target.gender) : target.gender);
 
-            if (filter.compare(result))
+            if ((searchFilter ? *searchFilter : target.filter).compare(result))
             {
-                result.setTarget(target);
                 result.setFrame(frame);
-
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(result);
+                result.setEncounter(index);
+                hits.emplace_back(result);
             }
         }
-        progress++;
     }
 }
@@ -19,161 +19,150 @@
 
 #include "WildSearcher7.hpp"
 #include <Core/Parents/WildResult.hpp>
-#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 #include <Core/RNG/SFMT.hpp>
+#include <Core/Util/StageTimer.hpp>
 #include <Core/Util/Utility.hpp>
 #include <Core/Util/WildType.hpp>
-#include <future>
 
 constexpr u8 grassSlots[10] = { 19, 39, 49, 59, 69, 79, 89, 94, 98, 99 };
 constexpr u8 waterSlots[3] = { 78, 98, 99 };
 
 WildSearcher7::WildSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, bool useSynch,
                              u8 synchNature, WildType type, u8 gender, const Profile7 &profile, const WildFilter &filter) :
+    Searcher(startTime, endTime, startFrame, endFrame, profile.getOffset()),
     profile(profile),
+    calendar(SeedCalendar7::find(profile.getTick(), profile.getOffset())),
     filter(filter),
-    startTime(startTime),
-    endTime(endTime),
-    startFrame(startFrame),
-    endFrame(endFrame),
     synchNature(synchNature),
     pidCount(profile.getShinyCharm() ? 3 : 1),
     gender(gender),
     useSynch(useSynch),
-    type(type),
-    progress(0),
-    searching(false)
+    type(type)
 {
 }
 
-void WildSearcher7::startSearch(int threads)
+u32 WildSearcher7::getInitialSeed(u64 epoch) const
 {
-    searching = true;
-
-    u64 epochStart = Utility::getCitraTime(startTime, profile.getOffset());
-    u64 epochEnd = Utility::getCitraTime(endTime, profile.getOffset());
-
-    u64 epochSplit = (epochEnd - epochStart) / threads;
-    epochSplit -= (epochSplit % 1000); // Floor to nearest thousand
+    return calendar ? calendar->getSeed(epoch) : Utility::calcInitialSeed(profile.getTick(), epoch);
+}
 
-    if (epochSplit < 1000)
+void WildSearcher7::getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const
+{
+    if (calendar)
     {
-        threads = 1;
+        calendar->getSeeds(epochs, count, seeds);
     }
-
-    std::vector<std::future<void>> threadContainer;
-    for (int i = 0; i < threads; i++)
+    else
     {
-        if (i == threads - 1)
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochEnd); }));
-        }
-        else
-        {
-            threadContainer.emplace_back(std::async(std::launch::async, [=] { search(epochStart, epochStart + epochSplit); }));
-        }
-        epochStart += epochSplit;
+        Utility::calcInitialSeeds(profile.getTick(), epochs, count, seeds);
     }
+}
 
-    for (int i = 0; i < threads; i++)
-    {
-        threadContainer[i].wait();
-    }
+u64 WildSearcher7::getIndexKey() const
+{
+    Hash hash;
+    addConfigHash(hash);
+    filter.addHash(hash);
+    return hash.get();
 }
 
-void WildSearcher7::cancelSearch()
+u64 WildSearcher7::getCacheKey() const
 {
-    searching = false;
+    Hash hash;
+    addConfigHash(hash);
+    return hash.get();
 }
 
-int WildSearcher7::getProgress() const
+std::unique_ptr<ResultFilter> WildSearcher7::getFilter() const
 {
-    return progress;
+    return std::make_unique<WildFilter>(filter);
 }
 
-int WildSearcher7::getMaxProgress() const
+bool WildSearcher7::compare(const ResultFilter &filter, const WildResult &result) const
 {
-    auto val = static_cast<int>(
-        (Utility::getCitraTime(endTime, profile.getOffset()) - Utility::getCitraTime(startTime, profile.getOffset())) / 1000);
-    return val + 1;
+    return static_cast<const WildFilter &>(filter).compare(result);
 }
 
-std::vector<WildResult> WildSearcher7::getResults()
+void WildSearcher7::addConfigHash(Hash &hash) const
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    auto data = std::move(results);
-    return data;
+    hash.add(std::string("WildSearcher7")).add(profile.getTID()).add(profile.getSID());
+    hash.add(synchNature).add(pidCount).add(gender).add(useSynch).add(type);
 }
 
-void WildSearcher7::search(u64 epochStart, u64 epochEnd)
+u64 WildSearcher7::getSeedKey() const
 {
-    u32 tick = profile.getTick();
-    u32 offset = profile.getOffset();
+    return profile.getTick();
+}
+
+void WildSearcher7::searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<WildResult> &hits)
+{
+    auto *searchFilter = static_cast<const WildFilter *>(filter);
+    auto kernel = [&](const u64 *window, u32 frame, u32 count) { searchWindow(initialSeed, window, frame, count, searchFilter, hits); };
+    RNGWindow<u64, SFMT>::search(initialSeed, frameStart, frameEnd, WindowList::lookahead, kernel, &control);
+}
+
+void WildSearcher7::searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const WildFilter *searchFilter,
+                                 std::vector<WildResult> &hits)
+{
+    STAGE_TIMER(Stage::FrameGeneration);
+
+    const WildFilter &active = searchFilter ? *searchFilter : filter;
+
     u16 tid = profile.getTID();
     u16 sid = profile.getSID();
 
-    DateTime target = DateTime(Utility::getNormalTime(epochStart, offset));
-    for (u64 epoch = epochStart; epoch <= epochEnd && searching; epoch += 1000, target.addSeconds(1))
+    for (u32 i = 0, frame = frameStart; i < count; i++, frame++)
     {
-        u32 initialSeed = Utility::calcInitialSeed(tick, epoch);
+        WindowList rngList(window + i);
 
-        SFMT sfmt(initialSeed, startFrame);
-        RNGList<u64, SFMT, 128> rngList(sfmt);
+        WildResult result(initialSeed, tid, sid);
 
-        for (u32 frame = startFrame; frame <= endFrame; frame++, rngList.advanceState())
-        {
-            WildResult result(initialSeed, tid, sid);
-
-            // Lead eats a call
-            bool synch = (rngList.getValue() % 100 >= 50) && useSynch;
+        // Lead eats a call
+        bool synch = (rngList.getValue() % 100 >= 50) && useSynch;
 
-            result.setEncounterSlot(getSlot(rngList.getValue() % 100));
+        result.setEncounterSlot(getSlot(rngList.getValue() % 100));
 
-            // Level eats a call
-            rngList.advanceFrames(1);
+        // Level eats a call
+        rngList.advanceFrames(1);
 
-            // Flute eats a call
-            rngList.advanceFrames(1);
+        // Flute eats a call
+        rngList.advanceFrames(1);
 
-            // If Minior eat a call, but I'm going to ignore this
+        // If Minior eat a call, but I'm going to ignore this
 
-            // Advance(60)
-            rngList.advanceFrames(60);
+        // Advance(60)
+        rngList.advanceFrames(60);
 
-            result.setEC(rngList.getValue() & 0xFFFFFFFF);
-
-            for (u8 i = 0; i < pidCount; i++)
-            {
-                result.setPID(rngList.getValue() & 0xffffffff);
-                if (result.getShiny())
-                {
-                    break;
-                }
-            }
+        result.setEC(rngList.getValue() & 0xFFFFFFFF);
 
-            for (u8 i = 0; i < 6; i++)
+        for (u8 i = 0; i < pidCount; i++)
+        {
+            result.setPID(rngList.getValue() & 0xffffffff);
+            if (result.getShiny())
             {
-                result.setIV(i, rngList.getValue() & 0x1f);
+                break;
             }
-            result.calcHiddenPower();
+        }
 
-            result.setAbility(rngList.getValue() & 1);
+        for (u8 i = 0; i < 6; i++)
+        {
+            result.setIV(i, rngList.getValue() & 0x1f);
+        }
+        result.calcHiddenPower();
 
-            result.setNature(synch ? synchNature : rngList.getValue() % 25);
+        result.setAbility(rngList.getValue() & 1);
 
-            // This might be wrong, it's probably fine though
-            result.setGender((gender > 0 && gender < 254) ? (rngList.getValue() % 252 >= gender ? 1 : 2) : gender);
+        result.setNature(synch ? synchNature : rngList.getValue() % 25);
 
-            if (filter.compare(result))
-            {
-                result.setTarget(target);
-                result.setFrame(frame);
+        // This might be wrong, it's probably fine though
+        result.setGender((gender > 0 && gender < 254) ? (rngList.getValue() % 252 >= gender ? 1 : 2) : gender);
 
-                std::lock_guard<std::mutex> lock(mutex);
-                results.emplace_back(result);
-            }
+        if (active.compare(result))
+        {
+            result.setFrame(frame);
+            hits.emplace_back(result);
         }
-        progress++;
     }
 }
 
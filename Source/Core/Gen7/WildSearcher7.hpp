@@ -21,40 +21,46 @@
 #define WILDSEARCHER7_HPP
 
 #include <Core/Gen7/Profile7.hpp>
+#include <Core/Gen7/SeedCalendar7.hpp>
+#include <Core/Parents/Searcher.hpp>
 #include <Core/Parents/WildFilter.hpp>
-#include <Core/Util/DateTime.hpp>
-#include <atomic>
-#include <mutex>
+#include <Core/Parents/WildResult.hpp>
+#include <Core/RNG/RNGWindow.hpp>
 
-class WildResult;
 enum WildType : int;
 
-class WildSearcher7
+class WildSearcher7 : public Searcher<WildResult>
 {
 public:
+    using WindowList = RNGWindowList<u64, 128>;
+
     WildSearcher7(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, bool useSynch, u8 synchNature,
                   WildType type, u8 gender, const Profile7 &profile, const WildFilter &filter);
-    void startSearch(int threads);
-    void cancelSearch();
-    int getProgress() const;
-    int getMaxProgress() const;
-    std::vector<WildResult> getResults();
+
+    // Searches count frames from frameStart with the values of a window shared between searches of the same seed.
+    // A search filter replaces the searcher's own filter when it isn't null.
+    void searchWindow(u32 initialSeed, const u64 *window, u32 frameStart, u32 count, const WildFilter *searchFilter,
+                      std::vector<WildResult> &hits);
 
 private:
     Profile7 profile;
+    std::shared_ptr<SeedCalendar7> calendar;
     WildFilter filter;
-    DateTime startTime, endTime;
-    u32 startFrame, endFrame;
     u8 synchNature, pidCount, gender;
     bool useSynch;
     WildType type;
 
-    std::vector<WildResult> results;
-    std::mutex mutex;
-    std::atomic_int progress;
-    bool searching;
+    u32 getInitialSeed(u64 epoch) const override;
+    void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const override;
+    u64 getIndexKey() const override;
+    u64 getSeedKey() const override;
+    u64 getCacheKey() const override;
+    std::unique_ptr<ResultFilter> getFilter() const override;
+    bool compare(const ResultFilter &filter, const WildResult &result) const override;
 
-    void search(u64 epochStart, u64 epochEnd);
+    // Hashes everything besides the filter that decides which frames are hits
+    void addConfigHash(Hash &hash) const;
+    void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<WildResult> &hits) override;
     u8 getSlot(u8 value);
 };
 
@@ -0,0 +1,377 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef BATCHSEARCHER_HPP
+#define BATCHSEARCHER_HPP
+
+#include <Core/Parents/Searcher.hpp>
+#include <Core/RNG/RNGWindow.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+
+// Runs several searchers of one generation as a single search. Searchers with the same seed function, date range, time
+// mask, offset and offset deltas whose frame ranges overlap form a group: each seed of the group is computed once and its
+// RNG window generated once over the union of the frame ranges, then every searcher of the group runs its kernel over its
+// own part of that window. Results, progress and the result callback of each searcher behave as if it had been searched
+// alone, except that the seed period and seed index shortcuts are not used.
+template <typename IntegerType, typename RNGType>
+class BatchSearcher
+{
+public:
+    template <class SearcherType>
+    void addJob(SearcherType *searcher)
+    {
+        jobs.emplace_back(std::make_unique<Job<SearcherType>>(searcher));
+    }
+
+    void startSearch(int threads)
+    {
+        control.start();
+        progress = 0;
+        STAGE_TIMER_RESET();
+
+        std::vector<Group> groups = getGroups();
+        std::vector<Unit> units;
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            for (const auto &run : groups[i].timeMask.getRuns(groups[i].epochStart, groups[i].epochEnd, groups[i].offset))
+            {
+                for (u64 epoch = run.first; epoch <= run.second; epoch += unitSeconds * 1000)
+                {
+                    units.push_back({ i, epoch, std::min(epoch + (unitSeconds - 1) * 1000, run.second) });
+                }
+            }
+        }
+
+        threads = std::max(1, std::min(threads, static_cast<int>(units.size())));
+        for (auto &job : jobs)
+        {
+            job->start(threads);
+        }
+
+        std::atomic<size_t> next = 0;
+
+        std::vector<std::future<void>> threadContainer;
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer.emplace_back(std::async(std::launch::async, [this, &groups, &units, &next, i] {
+                for (size_t index = next++; index < units.size() && control.poll(); index = next++)
+                {
+                    search(groups[units[index].group], units[index].epochStart, units[index].epochEnd, i);
+                }
+            }));
+        }
+
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer[i].wait();
+        }
+
+        for (auto &job : jobs)
+        {
+            job->stop();
+        }
+        STAGE_TIMER_REPORT();
+    }
+
+    void cancelSearch()
+    {
+        control.cancel();
+    }
+
+    void pauseSearch()
+    {
+        control.pause();
+    }
+
+    void resumeSearch()
+    {
+        control.resume();
+    }
+
+    bool isPaused() const
+    {
+        return control.isPaused();
+    }
+
+    // Seconds searched over all groups, a second counts once per group no matter how many searchers share it
+    u64 getProgress() const
+    {
+        return progress;
+    }
+
+    u64 getMaxProgress() const
+    {
+        u64 seconds = 0;
+        for (const auto &group : getGroups())
+        {
+            seconds += group.timeMask.getSeconds(group.epochStart, group.epochEnd, group.offset);
+        }
+        return seconds;
+    }
+
+    // Number of distinct seed streams, jobs sharing one only pay for its seeds and RNG window once
+    size_t getGroupCount() const
+    {
+        return getGroups().size();
+    }
+
+private:
+    static constexpr u64 unitSeconds = 64;
+
+    using GroupKey = std::tuple<u64, u32, u64, u64, std::vector<int>, u64>;
+
+    class JobBase
+    {
+    public:
+        virtual ~JobBase() = default;
+        virtual GroupKey getKey() const = 0;
+        virtual u32 getStartFrame() const = 0;
+        virtual u32 getEndFrame() const = 0;
+        virtual u32 getLookahead() const = 0;
+        virtual const TimeMask &getTimeMask() const = 0;
+        virtual void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const = 0;
+        virtual void start(int threads) = 0;
+        virtual void searchWindow(u32 worker, u32 initialSeed, const IntegerType *window, u32 frame, u32 count) = 0;
+        virtual void finishSeed(u32 worker, const DateTime &target, int delta) = 0;
+        virtual void finishSecond(u32 worker) = 0;
+        virtual void stop() = 0;
+    };
+
+    // Goes through the Searcher base since the seed functions and counters of the derived searchers are private
+    template <class SearcherType>
+    class Job : public JobBase
+    {
+        using ResultType = typename decltype(std::declval<SearcherType &>().getResults())::value_type;
+
+    public:
+        explicit Job(SearcherType *searcher) : searcher(searcher), base(searcher)
+        {
+        }
+
+        GroupKey getKey() const override
+        {
+            return { base->getSeedKey(), base->offset, Utility::getCitraTime(base->startTime, base->offset),
+                     Utility::getCitraTime(base->endTime, base->offset), base->offsetDeltas, base->timeMask.getKey() };
+        }
+
+        u32 getStartFrame() const override
+        {
+            return base->startFrame;
+        }
+
+        u32 getEndFrame() const override
+        {
+            return base->endFrame;
+        }
+
+        u32 getLookahead() const override
+        {
+            return SearcherType::WindowList::lookahead;
+        }
+
+        const TimeMask &getTimeMask() const override
+        {
+            return base->timeMask;
+        }
+
+        void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const override
+        {
+            base->getInitialSeeds(epochs, count, seeds);
+        }
+
+        void start(int threads) override
+        {
+            workers = std::vector<Worker>(threads);
+            base->control.start();
+            base->slices = 1;
+            base->startCounters();
+        }
+
+        void searchWindow(u32 worker, u32 initialSeed, const IntegerType *window, u32 frame, u32 count) override
+        {
+            u32 first = std::max(frame, base->startFrame);
+            u32 last = std::min(frame + count - 1, base->endFrame);
+            if (first <= last)
+            {
+                searcher->searchWindow(initialSeed, window + (first - frame), first, last - first + 1, nullptr, workers[worker].hits);
+            }
+        }
+
+        void finishSeed(u32 worker, const DateTime &target, int delta) override
+        {
+            auto &state = workers[worker];
+            for (size_t i = state.tagged; i < state.hits.size(); i++)
+            {
+                state.hits[i].setTarget(target, delta);
+            }
+            state.tagged = state.hits.size();
+            getCounter(worker).frames.fetch_add(static_cast<u64>(base->endFrame) - base->startFrame + 1, std::memory_order_relaxed);
+        }
+
+        void finishSecond(u32 worker) override
+        {
+            auto &state = workers[worker];
+            SearchCounters &counter = getCounter(worker);
+            counter.seeds.fetch_add(base->offsetDeltas.size(), std::memory_order_relaxed);
+            if (!state.hits.empty())
+            {
+                STAGE_TIMER(Stage::Publish);
+                std::lock_guard<std::mutex> lock(base->mutex);
+                counter.hits.fetch_add(state.hits.size(), std::memory_order_relaxed);
+                if (base->resultCallback)
+                {
+                    base->resultCallback(state.hits);
+                }
+                else
+                {
+                    base->results.insert(base->results.end(), state.hits.begin(), state.hits.end());
+                }
+                state.hits.clear();
+                state.tagged = 0;
+            }
+            counter.progress.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void stop() override
+        {
+            base->stopCounters();
+        }
+
+    private:
+        struct Worker
+        {
+            std::vector<ResultType> hits;
+            size_t tagged = 0;
+        };
+
+        SearcherType *searcher;
+        Searcher<ResultType> *base;
+        std::vector<Worker> workers;
+
+        SearchCounters &getCounter(u32 worker)
+        {
+            return base->counters[worker % base->counters.size()];
+        }
+    };
+
+    struct Group
+    {
+        u32 offset;
+        u64 epochStart, epochEnd;
+        std::vector<int> offsetDeltas;
+        u32 frameStart, frameEnd, lookahead;
+        TimeMask timeMask;
+        std::vector<JobBase *> jobs;
+    };
+
+    struct Unit
+    {
+        size_t group;
+        u64 epochStart, epochEnd;
+    };
+
+    std::vector<std::unique_ptr<JobBase>> jobs;
+    SearchControl control;
+    std::atomic<u64> progress = 0;
+
+    // Jobs are taken in order of their first frame. A job joins the last group of its key when its frames start before that
+    // group's window runs out, otherwise generating the gap for every seed would cost more than hashing the seeds again.
+    std::vector<Group> getGroups() const
+    {
+        std::vector<JobBase *> sorted;
+        for (const auto &job : jobs)
+        {
+            sorted.emplace_back(job.get());
+        }
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const JobBase *left, const JobBase *right) { return left->getStartFrame() < right->getStartFrame(); });
+
+        std::vector<Group> groups;
+        std::map<GroupKey, size_t> indexes;
+        for (auto *job : sorted)
+        {
+            GroupKey key = job->getKey();
+            auto it = indexes.find(key);
+            if (it == indexes.end()
+                || job->getStartFrame() > static_cast<u64>(groups[it->second].frameEnd) + groups[it->second].lookahead)
+            {
+                it = indexes.insert_or_assign(key, groups.size()).first;
+                groups.push_back({ std::get<1>(key), std::get<2>(key), std::get<3>(key), std::get<4>(key), job->getStartFrame(),
+                                   job->getEndFrame(), job->getLookahead(), job->getTimeMask(), {} });
+            }
+
+            Group &group = groups[it->second];
+            group.frameEnd = std::max(group.frameEnd, job->getEndFrame());
+            group.lookahead = std::max(group.lookahead, job->getLookahead());
+            group.jobs.emplace_back(job);
+        }
+        return groups;
+    }
+
+    void search(const Group &group, u64 epochStart, u64 epochEnd, u32 worker)
+    {
+        std::vector<u64> epochs;
+        for (u64 epoch = epochStart; epoch <= epochEnd; epoch += 1000)
+        {
+            for (int delta : group.offsetDeltas)
+            {
+                epochs.emplace_back(epoch + delta);
+            }
+        }
+
+        std::vector<u32> seeds(epochs.size());
+        {
+            STAGE_TIMER(Stage::SeedHash);
+            group.jobs.front()->getInitialSeeds(epochs.data(), static_cast<u32>(epochs.size()), seeds.data());
+        }
+
+        const u32 *seed = seeds.data();
+        DateTime target(Utility::getNormalTime(epochStart, group.offset));
+        for (u64 epoch = epochStart; epoch <= epochEnd && control.poll(); epoch += 1000, target.addSeconds(1))
+        {
+            for (int delta : group.offsetDeltas)
+            {
+                u32 initialSeed = *seed++;
+                auto kernel = [&](const IntegerType *window, u32 frame, u32 count) {
+                    for (auto *job : group.jobs)
+                    {
+                        job->searchWindow(worker, initialSeed, window, frame, count);
+                    }
+                };
+                RNGWindow<IntegerType, RNGType>::search(initialSeed, group.frameStart, group.frameEnd, group.lookahead, kernel, &control);
+
+                for (auto *job : group.jobs)
+                {
+                    job->finishSeed(worker, target, delta);
+                }
+            }
+
+            for (auto *job : group.jobs)
+            {
+                job->finishSecond(worker);
+            }
+            progress++;
+        }
+    }
+};
+
+#endif // BATCHSEARCHER_HPP
@@ -19,6 +19,7 @@
 
 #include "EventFilter.hpp"
 #include <Core/Parents/EventResult.hpp>
+#include <Core/Util/StageTimer.hpp>
 
 EventFilter::EventFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                          const std::vector<bool> &hiddenPower, u8 ability, u8 shiny, u8 gender) :
@@ -26,8 +27,10 @@ EventFilter::EventFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6>
 {
 }
 
-bool EventFilter::compare(const EventResult &frame)
+bool EventFilter::compare(const EventResult &frame) const
 {
+    STAGE_TIMER(Stage::Filter);
+
     if (shiny != 255 && !(shiny & frame.getShiny()))
     {
         return false;
@@ -29,7 +29,7 @@ class EventFilter : public ResultFilter
 public:
     EventFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                 const std::vector<bool> &hiddenPower, u8 ability, u8 shiny, u8 gender);
-    bool compare(const EventResult &frame);
+    bool compare(const EventResult &frame) const;
 };
 
 #endif // EVENTFILTER_HPP
@@ -20,10 +20,11 @@
 #include "IDFilter.hpp"
 #include <Core/Parents/IDResult.hpp>
 #include <Core/Util/IDType.hpp>
-#include <algorithm>
+#include <Core/Util/StageTimer.hpp>
 #include <sstream>
 
-IDFilter::IDFilter(const std::string &idList, const std::string &tsvList, IDType type) : idType(type)
+IDFilter::IDFilter(const std::string &idList, const std::string &tsvList, IDType type) :
+    tidFilter(0x10000), sidFilter(0x10000), tsvFilter(0x10000), g7Filter(1000000), idType(type)
 {
     checkID = !idList.empty();
     checkTSV = !tsvList.empty();
@@ -37,22 +38,28 @@ IDFilter::IDFilter(const std::string &idList, const std::string &tsvList, IDType
             switch (idType)
             {
             case IDType::TID:
-                tidFilter.emplace_back(std::stoul(item));
+                tidFilter[std::stoul(item) & 0xffff] = true;
                 break;
             case IDType::SID:
-                sidFilter.emplace_back(std::stoul(item));
+                sidFilter[std::stoul(item) & 0xffff] = true;
                 break;
             case IDType::TIDSID:
             {
                 int index = item.find('/');
-                tidFilter.emplace_back(std::stoul(item.substr(0, index)));
-                sidFilter.emplace_back(std::stoul(item.substr(index + 1, std::string::npos)));
+                tidFilter[std::stoul(item.substr(0, index)) & 0xffff] = true;
+                sidFilter[std::stoul(item.substr(index + 1, std::string::npos)) & 0xffff] = true;
                 break;
             }
             case IDType::G7TID:
-                g7Filter.emplace_back(std::stoul(item));
+            {
+                u32 displayTID = std::stoul(item);
+                if (displayTID < 1000000)
+                {
+                    g7Filter[displayTID] = true;
+                }
                 break;
             }
+            }
         }
     }
 
@@ -62,38 +69,44 @@ IDFilter::IDFilter(const std::string &idList, const std::string &tsvList, IDType
         std::string item;
         while (std::getline(stream, item, '\n'))
         {
-            tsvFilter.emplace_back(std::stoul(item));
+            tsvFilter[std::stoul(item) & 0xffff] = true;
         }
     }
 }
 
-bool IDFilter::compare(const IDResult &frame)
+bool IDFilter::compare(const IDResult &frame) const
+{
+    return compare(frame.getTID(), frame.getSID(), frame.getTSV(), frame.getDisplayTID());
+}
+
+bool IDFilter::compare(u16 tid, u16 sid, u16 tsv, u32 displayTID) const
 {
+    STAGE_TIMER(Stage::Filter);
+
     if (checkID)
     {
         switch (idType)
         {
         case IDType::TID:
-            if (std::find(tidFilter.begin(), tidFilter.end(), frame.getTID()) == tidFilter.end())
+            if (!tidFilter[tid])
             {
                 return false;
             }
             break;
         case IDType::SID:
-            if (std::find(sidFilter.begin(), sidFilter.end(), frame.getSID()) == sidFilter.end())
+            if (!sidFilter[sid])
             {
                 return false;
             }
             break;
         case IDType::TIDSID:
-            if (std::find(tidFilter.begin(), tidFilter.end(), frame.getTID()) == tidFilter.end()
-                || std::find(sidFilter.begin(), sidFilter.end(), frame.getSID()) == sidFilter.end())
+            if (!tidFilter[tid] || !sidFilter[sid])
             {
                 return false;
             }
             break;
         case IDType::G7TID:
-            if (std::find(g7Filter.begin(), g7Filter.end(), frame.getDisplayTID()) == g7Filter.end())
+            if (!g7Filter[displayTID])
             {
                 return false;
             }
@@ -101,13 +114,15 @@ bool IDFilter::compare(const IDResult &frame)
         }
     }
 
-    if (checkTSV)
+    if (checkTSV && !tsvFilter[tsv])
     {
-        if (std::find(tsvFilter.begin(), tsvFilter.end(), frame.getTSV()) == tsvFilter.end())
-        {
-            return false;
-        }
+        return false;
     }
 
     return true;
 }
+
+void IDFilter::addHash(Hash &hash) const
+{
+    hash.add(tidFilter).add(sidFilter).add(tsvFilter).add(g7Filter).add(idType).add(checkID).add(checkTSV);
+}
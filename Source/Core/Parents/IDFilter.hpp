@@ -20,7 +20,7 @@
 #ifndef IDFILTER_HPP
 #define IDFILTER_HPP
 
-#include <Core/Util/Global.hpp>
+#include <Core/Util/Hash.hpp>
 #include <string>
 #include <vector>
 
@@ -32,13 +32,16 @@ class IDFilter
 public:
     IDFilter() = default;
     IDFilter(const std::string &idList, const std::string &tsvList, IDType type);
-    bool compare(const IDResult &frame);
+    bool compare(const IDResult &frame) const;
+    bool compare(u16 tid, u16 sid, u16 tsv, u32 displayTID) const;
+    void addHash(Hash &hash) const;
 
 private:
-    std::vector<u16> tidFilter;
-    std::vector<u16> sidFilter;
-    std::vector<u16> tsvFilter;
-    std::vector<u32> g7Filter;
+    // Lists are compiled into bitsets indexed by value so each frame is a constant time lookup
+    std::vector<bool> tidFilter;
+    std::vector<bool> sidFilter;
+    std::vector<bool> tsvFilter;
+    std::vector<bool> g7Filter;
     IDType idType;
     bool checkID;
     bool checkTSV;
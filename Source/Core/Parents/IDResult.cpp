@@ -20,7 +20,14 @@
 #include "IDResult.hpp"
 
 IDResult::IDResult(u32 seed, u32 frame, u32 rand) :
-    seed(seed), frame(frame), displayTID(rand % 1000000), tid(rand & 0xffff), sid(rand >> 16), tsv((tid ^ sid) >> 4)
+    offsetDelta(0),
+    seed(seed),
+    frame(frame),
+    displayTID(rand % 1000000),
+    tid(rand & 0xffff),
+    sid(rand >> 16),
+    tsv((tid ^ sid) >> 4),
+    shinyCount(0)
 {
 }
 
@@ -59,7 +66,23 @@ u32 IDResult::getDisplayTID() const
     return displayTID;
 }
 
-void IDResult::setTarget(const DateTime &target)
+u16 IDResult::getShinyCount() const
+{
+    return shinyCount;
+}
+
+void IDResult::setShinyCount(u16 shinyCount)
+{
+    this->shinyCount = shinyCount;
+}
+
+void IDResult::setTarget(const DateTime &target, int offsetDelta)
 {
     this->target = target;
+    this->offsetDelta = offsetDelta;
+}
+
+int IDResult::getOffsetDelta() const
+{
+    return offsetDelta;
 }
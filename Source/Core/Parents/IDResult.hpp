@@ -36,12 +36,16 @@ public:
     u16 getSID() const;
     u16 getTSV() const;
     u32 getDisplayTID() const;
-    void setTarget(const DateTime &target);
+    u16 getShinyCount() const;
+    void setShinyCount(u16 shinyCount);
+    void setTarget(const DateTime &target, int offsetDelta = 0);
+    int getOffsetDelta() const;
 
 private:
     DateTime target;
+    int offsetDelta;
     u32 seed, frame, displayTID;
-    u16 tid, sid, tsv;
+    u16 tid, sid, tsv, shinyCount;
 };
 
 #endif // IDRESULT_HPP
@@ -19,7 +19,7 @@
 
 #include "Result.hpp"
 
-Result::Result(u32 seed, u16 tid, u16 sid) : seed(seed), tsv(tid ^ sid), ivs { 255, 255, 255, 255, 255, 255 }
+Result::Result(u32 seed, u16 tid, u16 sid) : offsetDelta(0), seed(seed), tsv(tid ^ sid), ivs { 255, 255, 255, 255, 255, 255 }
 {
 }
 
@@ -28,9 +28,15 @@ std::string Result::getDateTime() const
     return target.toString();
 }
 
-void Result::setTarget(const DateTime &target)
+void Result::setTarget(const DateTime &target, int offsetDelta)
 {
     this->target = target;
+    this->offsetDelta = offsetDelta;
+}
+
+int Result::getOffsetDelta() const
+{
+    return offsetDelta;
 }
 
 u32 Result::getSeed() const
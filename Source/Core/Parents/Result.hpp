@@ -31,7 +31,8 @@ public:
     Result() = default;
     Result(u32 seed, u16 tid, u16 sid);
     std::string getDateTime() const;
-    void setTarget(const DateTime &target);
+    void setTarget(const DateTime &target, int offsetDelta = 0);
+    int getOffsetDelta() const;
     u32 getSeed() const;
     u32 getPID() const;
     void setPID(const u32 pid);
@@ -56,6 +57,7 @@ public:
 
 protected:
     DateTime target;
+    int offsetDelta;
     u32 seed, pid, ec, frame;
     u16 tsv;
     u8 hiddenPower, ability, nature, gender, shiny;
@@ -0,0 +1,105 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <Core/Parents/ResultFilter.hpp>
+#include <future>
+#include <memory>
+#include <vector>
+
+// Results of the last search of a configuration together with the filter they were searched with. A later search of
+// the same configuration whose filter the cached one contains is answered by filtering the cache again. Only one search
+// may use a cache at a time.
+template <typename ResultType>
+class ResultCache
+{
+public:
+    explicit ResultCache(size_t maximumResults = 1000000) : key(0), maximumResults(maximumResults)
+    {
+    }
+
+    bool covers(u64 key, const ResultFilter &filter) const
+    {
+        return this->filter && this->key == key && this->filter->contains(filter);
+    }
+
+    // Searches expecting more results than this keep their own filter instead of a widened one, and are not
+    // cached at all if they still find more
+    size_t getMaximumResults() const
+    {
+        return maximumResults;
+    }
+
+    void store(u64 key, std::unique_ptr<ResultFilter> filter, std::vector<ResultType> results)
+    {
+        this->key = key;
+        this->filter = std::move(filter);
+        this->results = std::move(results);
+    }
+
+    void clear()
+    {
+        filter.reset();
+        results.clear();
+        results.shrink_to_fit();
+    }
+
+    // Returns the cached results compare() accepts in their cached order, each thread scans a contiguous part
+    template <class Compare>
+    std::vector<ResultType> scan(Compare compare, int threads) const
+    {
+        threads = std::max(1, std::min<int>(threads, static_cast<int>(results.size() / 4096) + 1));
+        size_t part = (results.size() + threads - 1) / threads;
+
+        std::vector<std::future<std::vector<ResultType>>> threadContainer;
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer.emplace_back(std::async(std::launch::async, [this, &compare, part, i] {
+                std::vector<ResultType> matches;
+                size_t end = std::min(results.size(), part * (i + 1));
+                for (size_t j = part * i; j < end; j++)
+                {
+                    if (compare(results[j]))
+                    {
+                        matches.emplace_back(results[j]);
+                    }
+                }
+                return matches;
+            }));
+        }
+
+        std::vector<ResultType> matches;
+        for (auto &thread : threadContainer)
+        {
+            auto found = thread.get();
+            matches.insert(matches.end(), found.begin(), found.end());
+        }
+        return matches;
+    }
+
+private:
+    u64 key;
+    std::unique_ptr<ResultFilter> filter;
+    std::vector<ResultType> results;
+    size_t maximumResults;
+};
+
+#endif // RESULTCACHE_HPP
@@ -20,7 +20,8 @@
 #ifndef RESULTFILTER_HPP
 #define RESULTFILTER_HPP
 
-#include <Core/Util/Global.hpp>
+#include <Core/Util/Hash.hpp>
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -33,6 +34,66 @@ public:
     {
     }
 
+    virtual ~ResultFilter() = default;
+
+    void addHash(Hash &hash) const
+    {
+        hash.add(minIV).add(maxIV).add(nature).add(hiddenPower).add(ability).add(gender).add(shiny);
+    }
+
+    // True if every frame the other filter of the same type passes is passed by this one as well
+    virtual bool contains(const ResultFilter &other) const
+    {
+        for (u8 i = 0; i < 6; i++)
+        {
+            if (other.minIV[i] < minIV[i] || other.maxIV[i] > maxIV[i])
+            {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < nature.size(); i++)
+        {
+            if (other.nature[i] && !nature[i])
+            {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < hiddenPower.size(); i++)
+        {
+            if (other.hiddenPower[i] && !hiddenPower[i])
+            {
+                return false;
+            }
+        }
+
+        return (ability == 255 || ability == other.ability) && (gender == 255 || gender == other.gender)
+            && (shiny == 255 || (other.shiny != 255 && (other.shiny & ~shiny) == 0));
+    }
+
+    // Keeps only the IV ranges, the frames this passes can be filtered again for any nature, hidden power, ability,
+    // gender or shininess
+    virtual void widen()
+    {
+        std::fill(nature.begin(), nature.end(), true);
+        std::fill(hiddenPower.begin(), hiddenPower.end(), true);
+        ability = 255;
+        gender = 255;
+        shiny = 255;
+    }
+
+    // Share of fully random IV spreads that fall inside the IV ranges
+    double getIVShare() const
+    {
+        double share = 1;
+        for (u8 i = 0; i < 6; i++)
+        {
+            share *= minIV[i] > maxIV[i] ? 0 : (maxIV[i] - minIV[i] + 1) / 32.0;
+        }
+        return share;
+    }
+
 protected:
     std::array<u8, 6> minIV, maxIV;
     std::vector<bool> nature, hiddenPower;
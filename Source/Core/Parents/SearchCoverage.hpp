@@ -0,0 +1,89 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHCOVERAGE_HPP
+#define SEARCHCOVERAGE_HPP
+
+#include <Core/Util/Global.hpp>
+#include <vector>
+
+struct SearchTile
+{
+    u64 epochStart;
+    u64 epochEnd;
+    u32 frameStart;
+    u32 frameEnd;
+};
+
+// Configuration and range of the last completed search of a form. A later search of the same configuration over a
+// range containing the covered one only has to search the difference.
+class SearchCoverage
+{
+public:
+    SearchCoverage() : key(0), range {}
+    {
+    }
+
+    bool extends(u64 key, const SearchTile &range) const
+    {
+        return key != 0 && this->key == key && range.epochStart <= this->range.epochStart && range.epochEnd >= this->range.epochEnd
+            && range.frameStart <= this->range.frameStart && range.frameEnd >= this->range.frameEnd;
+    }
+
+    // Splits the part of the range outside the covered one into up to four rectangles: the earlier and later seconds
+    // over every frame, then the lower and higher frames of the covered seconds
+    std::vector<SearchTile> getMissing(const SearchTile &range) const
+    {
+        std::vector<SearchTile> missing;
+        if (range.epochStart < this->range.epochStart)
+        {
+            missing.push_back({ range.epochStart, this->range.epochStart - 1000, range.frameStart, range.frameEnd });
+        }
+        if (range.epochEnd > this->range.epochEnd)
+        {
+            missing.push_back({ this->range.epochEnd + 1000, range.epochEnd, range.frameStart, range.frameEnd });
+        }
+        if (range.frameStart < this->range.frameStart)
+        {
+            missing.push_back({ this->range.epochStart, this->range.epochEnd, range.frameStart, this->range.frameStart - 1 });
+        }
+        if (range.frameEnd > this->range.frameEnd)
+        {
+            missing.push_back({ this->range.epochStart, this->range.epochEnd, this->range.frameEnd + 1, range.frameEnd });
+        }
+        return missing;
+    }
+
+    void store(u64 key, const SearchTile &range)
+    {
+        this->key = key;
+        this->range = range;
+    }
+
+    void clear()
+    {
+        key = 0;
+    }
+
+private:
+    u64 key;
+    SearchTile range;
+};
+
+#endif // SEARCHCOVERAGE_HPP
@@ -0,0 +1,109 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHHISTOGRAM_HPP
+#define SEARCHHISTOGRAM_HPP
+
+#include <Core/Util/Global.hpp>
+#include <limits>
+#include <map>
+#include <tuple>
+
+// Hits of one hour or day, with the lowest frame any of them was found at and the second and seed it came from.
+// Ties go to the earliest second and then the lowest offset delta, so the best hit doesn't depend on the order
+// workers merge in.
+struct HistogramBucket
+{
+    u64 hits = 0;
+    u32 bestFrame = std::numeric_limits<u32>::max();
+    u32 bestSeed = 0;
+    int bestDelta = 0;
+    u64 bestTime = 0;
+
+    void add(u32 frame, u32 seed, int delta, u64 time, u64 count = 1)
+    {
+        hits += count;
+        if (std::tie(frame, time, delta) < std::tie(bestFrame, bestTime, bestDelta))
+        {
+            bestFrame = frame;
+            bestSeed = seed;
+            bestDelta = delta;
+            bestTime = time;
+        }
+    }
+
+    void merge(const HistogramBucket &other)
+    {
+        add(other.bestFrame, other.bestSeed, other.bestDelta, other.bestTime, other.hits);
+    }
+};
+
+// Hit counts of a search by the hour it was found at, for searches that only need to know when the hits are instead
+// of every result. Hours and days are counted since 1970 in the local time of the dates searched, times are in seconds.
+class SearchHistogram
+{
+public:
+    void add(u64 time, u32 frame, u32 seed, int delta)
+    {
+        hours[time / 3600].add(frame, seed, delta, time);
+    }
+
+    void merge(const SearchHistogram &other)
+    {
+        for (const auto &[hour, bucket] : other.hours)
+        {
+            hours[hour].merge(bucket);
+        }
+    }
+
+    void clear()
+    {
+        hours.clear();
+    }
+
+    const std::map<u64, HistogramBucket> &getHours() const
+    {
+        return hours;
+    }
+
+    std::map<u64, HistogramBucket> getDays() const
+    {
+        std::map<u64, HistogramBucket> days;
+        for (const auto &[hour, bucket] : hours)
+        {
+            days[hour / 24].merge(bucket);
+        }
+        return days;
+    }
+
+    u64 getHits() const
+    {
+        u64 hits = 0;
+        for (const auto &[hour, bucket] : hours)
+        {
+            hits += bucket.hits;
+        }
+        return hits;
+    }
+
+private:
+    std::map<u64, HistogramBucket> hours;
+};
+
+#endif // SEARCHHISTOGRAM_HPP
@@ -0,0 +1,59 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHSTATS_HPP
+#define SEARCHSTATS_HPP
+
+#include <Core/Util/Global.hpp>
+#include <atomic>
+
+// Snapshot of a running or finished search, rates are averaged over the elapsed time
+struct SearchStats
+{
+    u64 progress;
+    u64 maxProgress;
+    u64 seeds;
+    u64 frames;
+    u64 hits;
+    double elapsed;
+    double seedsPerSecond;
+    double framesPerSecond;
+    // Estimated seconds remaining, negative until there is enough progress to estimate from
+    double eta;
+};
+
+// Counters of a single worker. Each worker gets its own cache line so increments don't contend,
+// readers sum every worker's counters.
+struct alignas(64) SearchCounters
+{
+    std::atomic<u64> progress { 0 };
+    std::atomic<u64> seeds { 0 };
+    std::atomic<u64> frames { 0 };
+    std::atomic<u64> hits { 0 };
+
+    void reset()
+    {
+        progress.store(0, std::memory_order_relaxed);
+        seeds.store(0, std::memory_order_relaxed);
+        frames.store(0, std::memory_order_relaxed);
+        hits.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif // SEARCHSTATS_HPP
@@ -0,0 +1,1211 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHER_HPP
+#define SEARCHER_HPP
+
+#include <Core/Parents/ResultCache.hpp>
+#include <Core/Parents/SearchCoverage.hpp>
+#include <Core/Parents/SearchHistogram.hpp>
+#include <Core/Parents/SearchStats.hpp>
+#include <Core/Util/DateTime.hpp>
+#include <Core/Util/Hash.hpp>
+#include <Core/Util/SearchControl.hpp>
+#include <Core/Util/SearchJournal.hpp>
+#include <Core/Util/SeedIndex.hpp>
+#include <Core/Util/StageTimer.hpp>
+#include <Core/Util/TimeMask.hpp>
+#include <Core/Util/TraceRecorder.hpp>
+#include <Core/Util/Utility.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+template <typename IntegerType, typename RNGType>
+class BatchSearcher;
+
+template <typename ResultType>
+class Searcher
+{
+    // Batches drive several searchers over one shared seed and RNG window loop
+    template <typename, typename>
+    friend class BatchSearcher;
+
+public:
+    Searcher(const DateTime &startTime, const DateTime &endTime, u32 startFrame, u32 endFrame, u32 offset) :
+        startTime(startTime),
+        endTime(endTime),
+        startFrame(startFrame),
+        endFrame(endFrame),
+        offset(offset),
+        offsetDeltas({ 0 }),
+        seedPeriod(0),
+        epochEnd(0),
+        slices(1),
+        caching(false),
+        cacheKey(0),
+        incremental(false),
+        incrementalSeconds(0),
+        journalKey(0),
+        resultLimit(0),
+        anchored(false),
+        anchorEpoch(0),
+        anchorRadius(0),
+        limitKey(0),
+        tileFrontier(0),
+        orderPublished(0),
+        startClock(0),
+        stopClock(0),
+        pausedClock(0)
+    {
+    }
+
+    virtual ~Searcher() = default;
+
+    void startSearch(int threads)
+    {
+        control.start();
+        incremental = isIncremental();
+        incrementalSeconds = 0;
+        startCounters();
+        STAGE_TIMER_RESET();
+
+        // An interrupted search of the same configuration is resumed with the tiles it was split into
+        int tileThreads = threads;
+        bool resumed = loadJournal(tileThreads);
+        if (!incremental && !resumed && startCache(threads))
+        {
+            finishCoverage();
+            stopCounters();
+            STAGE_TIMER_REPORT();
+            return;
+        }
+
+        std::vector<SearchTile> tiles = getTiles(tileThreads);
+        startOrder(tiles);
+        startJournal(tiles, tileThreads);
+        threads = std::max(1, std::min(threads, static_cast<int>(tiles.size())));
+        if (!tracePath.empty())
+        {
+            trace.start(threads);
+        }
+        workerHistograms.assign(histogram ? threads : 0, SearchHistogram());
+
+        // Tiles are handed out in order to whichever thread is free so uneven tiles don't leave threads idle
+        std::atomic<size_t> next = 0;
+
+        std::vector<std::future<void>> threadContainer;
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer.emplace_back(std::async(std::launch::async, [this, &tiles, &next, i] {
+                SearchCounters &counter = counters[i % counters.size()];
+                std::vector<ResultType> published;
+                for (size_t index = next++; index < tiles.size() && control.poll(); index = next++)
+                {
+                    if (journal.isFinished(static_cast<u32>(index)))
+                    {
+                        continue;
+                    }
+
+                    // Ordered searches skip tiles without a second before the last of the hits they keep
+                    if (isOrdered() && tileKeys[index] > limitKey.load(std::memory_order_relaxed))
+                    {
+                        finishTile(index);
+                        continue;
+                    }
+
+                    u64 tileStart = trace.now();
+                    search(tiles[index], counter, i, journal.isOpen() ? &published : nullptr);
+                    trace.complete(i, "Tile", tileStart, trace.now(), "tile", index);
+
+                    // A cancelled tile stopped partway and is searched again on resume
+                    if (!control.isCancelled())
+                    {
+                        if (journal.isOpen())
+                        {
+                            journal.add(static_cast<u32>(index), published.data(), static_cast<u32>(published.size()));
+                        }
+                        finishTile(index);
+                    }
+                    published.clear();
+                }
+            }));
+        }
+
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer[i].wait();
+        }
+        finishOrder();
+        finishHistogram();
+        finishCache();
+        finishCoverage();
+        finishJournal();
+        stopCounters();
+        STAGE_TIMER_REPORT();
+
+        if (trace.isEnabled())
+        {
+            trace.write(tracePath);
+        }
+    }
+
+    // Searches every second at each of these millisecond deltas from the profile offset instead of only the offset itself
+    void setOffsetDeltas(const std::vector<int> &deltas)
+    {
+        offsetDeltas = deltas;
+        std::sort(offsetDeltas.begin(), offsetDeltas.end());
+        offsetDeltas.erase(std::unique(offsetDeltas.begin(), offsetDeltas.end()), offsetDeltas.end());
+        if (offsetDeltas.empty())
+        {
+            offsetDeltas.emplace_back(0);
+        }
+    }
+
+    // Workers see a cancel or pause before their next chunk of frames
+    void cancelSearch()
+    {
+        trace.instantPoll("Cancel");
+        control.cancel();
+    }
+
+    // Paused workers wait without using the CPU until the search is resumed or cancelled
+    void pauseSearch()
+    {
+        trace.instantPoll("Pause");
+        control.pause();
+    }
+
+    void resumeSearch()
+    {
+        trace.instantPoll("Resume");
+        control.resume();
+    }
+
+    bool isPaused() const
+    {
+        return control.isPaused();
+    }
+
+    // Hands results to the callback as soon as a worker publishes them instead of keeping them for getResults().
+    // Calls are serialized by the results lock so the callback doesn't need its own.
+    void setResultCallback(const std::function<void(const std::vector<ResultType> &)> &callback)
+    {
+        resultCallback = callback;
+    }
+
+    // Keeps the results of each search in the cache, searches that only tighten the filter of the cached search are
+    // answered by filtering the cache again. A form can share one cache between the searchers it creates.
+    void setResultCache(const std::shared_ptr<ResultCache<ResultType>> &cache)
+    {
+        resultCache = cache;
+    }
+
+    // Remembers the configuration and range of each completed search, a search of the same configuration over a range
+    // containing the last one then only searches the seconds and frames it adds. A form can share one coverage between
+    // the searchers it creates.
+    void setSearchCoverage(const std::shared_ptr<SearchCoverage> &coverage)
+    {
+        this->coverage = coverage;
+    }
+
+    // True when the next search only finds the results the last completed search didn't
+    bool isIncremental() const
+    {
+        return !isOrdered() && !timeMask.isEnabled() && !histogram && coverage && coverage->extends(getCoverageKey(), getRange());
+    }
+
+    // Records each finished tile and its results in a journal at the path. A later search of the same configuration
+    // and range resumes from it, the journal is removed once a search completes. An empty path turns journaling off.
+    void setJournalPath(const std::string &path)
+    {
+        journalPath = path;
+    }
+
+    // Only finds the earliest hits, or the closest to the anchor when one is set. Tiles are searched in that order and
+    // seconds after the last of the hits found so far are skipped. 0 finds every hit.
+    void setResultLimit(u32 limit)
+    {
+        resultLimit = limit;
+    }
+
+    // Searches outward from the anchor in both directions, closest seconds first. Only seconds within the radius of it
+    // are searched, 0 searches the whole range.
+    void setAnchor(const DateTime &anchor, u64 radius)
+    {
+        anchored = true;
+        anchorEpoch = Utility::getCitraTime(anchor, offset);
+        anchorRadius = radius;
+    }
+
+    void clearAnchor()
+    {
+        anchored = false;
+    }
+
+    // Counts the hits of each following search by hour into the histogram instead of keeping them as results. Workers
+    // count into their own histograms which are merged once the search finishes. nullptr keeps the results again.
+    void setHistogram(const std::shared_ptr<SearchHistogram> &histogram)
+    {
+        this->histogram = histogram;
+    }
+
+    // Only searches the seconds the mask allows, the rest of the range is skipped without computing their seeds
+    void setTimeMask(const TimeMask &mask)
+    {
+        timeMask = mask;
+    }
+
+    const TimeMask &getTimeMask() const
+    {
+        return timeMask;
+    }
+
+    // Writes a Chrome trace event timeline of each following search to the path, an empty path turns tracing off
+    void setTracePath(const std::string &path)
+    {
+        tracePath = path;
+    }
+
+    u64 getProgress() const
+    {
+        u64 progress = 0;
+        for (const auto &counter : counters)
+        {
+            progress += counter.progress.load(std::memory_order_relaxed);
+        }
+        return progress / slices;
+    }
+
+    u64 getMaxProgress() const
+    {
+        if (incremental)
+        {
+            return incrementalSeconds;
+        }
+
+        if (anchored || timeMask.isEnabled())
+        {
+            SearchTile range = anchored ? getAnchorRange() : getRange();
+            if (range.epochStart > range.epochEnd)
+            {
+                return 0;
+            }
+            return timeMask.getSeconds(range.epochStart, range.epochEnd, offset);
+        }
+
+        u64 seconds = (Utility::getCitraTime(endTime, offset) - Utility::getCitraTime(startTime, offset)) / 1000 + 1;
+        if (seedPeriod != 0)
+        {
+            seconds = std::min(seconds, seedPeriod);
+        }
+        return seconds;
+    }
+
+    SearchStats getStats() const
+    {
+        SearchStats stats {};
+        stats.progress = getProgress();
+        stats.maxProgress = getMaxProgress();
+        for (const auto &counter : counters)
+        {
+            stats.seeds += counter.seeds.load(std::memory_order_relaxed);
+            stats.frames += counter.frames.load(std::memory_order_relaxed);
+            stats.hits += counter.hits.load(std::memory_order_relaxed);
+        }
+
+        auto start = startClock.load();
+        if (start != 0)
+        {
+            // Time spent paused doesn't count towards the rates and ETA
+            auto stop = stopClock.load();
+            auto end = stop != 0 ? stop : std::chrono::steady_clock::now().time_since_epoch().count();
+            auto paused = stop != 0 ? pausedClock.load() : control.getPausedTime().count();
+            stats.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::duration(end - start - paused)).count();
+        }
+
+        if (stats.elapsed > 0)
+        {
+            stats.seedsPerSecond = stats.seeds / stats.elapsed;
+            stats.framesPerSecond = stats.frames / stats.elapsed;
+        }
+
+        stats.eta = -1;
+        if (stats.progress >= stats.maxProgress)
+        {
+            stats.eta = 0;
+        }
+        else if (stats.progress != 0 && stats.elapsed > 0)
+        {
+            stats.eta = stats.elapsed * (stats.maxProgress - stats.progress) / stats.progress;
+        }
+        return stats;
+    }
+
+    std::vector<ResultType> getResults()
+    {
+        u64 waitStart = trace.now();
+        std::lock_guard<std::mutex> lock(mutex);
+        u64 holdStart = trace.now();
+
+        auto data = std::move(results);
+        trace.completePoll("getResults wait", waitStart, holdStart);
+        trace.completePoll("getResults", holdStart, trace.now(), "results", data.size());
+        return data;
+    }
+
+    // Uses a previously built seed index from the directory if one matches this configuration and frame range
+    bool loadSeedIndex(const std::string &directory)
+    {
+        return seedIndex.load(directory, getIndexKey(), startFrame, endFrame);
+    }
+
+    // Runs the kernel over every 32 bit seed and records which seeds have a hit. Progress counts finished
+    // blocks of 65536 seeds out of 65536.
+    bool buildSeedIndex(const std::string &directory, int threads)
+    {
+        SeedIndex index;
+        if (!index.create(directory, getIndexKey(), startFrame, endFrame))
+        {
+            return false;
+        }
+
+        control.start();
+        startCounters();
+
+        // Each block is a contiguous run of seeds so threads never write to the same byte of the index
+        std::atomic<u32> next = 0;
+
+        std::vector<std::future<void>> threadContainer;
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer.emplace_back(std::async(std::launch::async, [this, &index, &next, i] {
+                SearchCounters &counter = counters[i % counters.size()];
+                std::vector<ResultType> hits;
+                for (u32 block = next++; block < 0x10000 && control.poll(); block = next++)
+                {
+                    for (u32 low = 0; low < 0x10000; low++)
+                    {
+                        u32 seed = (block << 16) | low;
+                        searchSeed(seed, startFrame, endFrame, nullptr, hits);
+                        if (!hits.empty())
+                        {
+                            index.set(seed);
+                            hits.clear();
+                        }
+                    }
+                    counter.progress.fetch_add(1, std::memory_order_relaxed);
+                    counter.seeds.fetch_add(0x10000, std::memory_order_relaxed);
+                    counter.frames.fetch_add(0x10000ull * (endFrame - startFrame + 1), std::memory_order_relaxed);
+                }
+            }));
+        }
+
+        for (int i = 0; i < threads; i++)
+        {
+            threadContainer[i].wait();
+        }
+        stopCounters();
+
+        if (control.isCancelled())
+        {
+            index.discard();
+            return false;
+        }
+        return index.finish();
+    }
+
+protected:
+    DateTime startTime, endTime;
+    u32 startFrame, endFrame;
+    u32 offset;
+    std::vector<int> offsetDeltas;
+
+    // Number of seconds after which getInitialSeed() starts repeating, 0 if it never does
+    u64 seedPeriod;
+
+    std::vector<ResultType> results;
+    std::mutex mutex;
+
+    // Searchers pass it to RNGWindow::search() so long frame ranges see cancels and pauses within a chunk
+    SearchControl control;
+
+    virtual u32 getInitialSeed(u64 epoch) const = 0;
+
+    // Searchers with a batched seed function override this, the default computes seeds one at a time
+    virtual void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const
+    {
+        for (u32 i = 0; i < count; i++)
+        {
+            seeds[i] = getInitialSeed(epochs[i]);
+        }
+    }
+
+    // Identifies everything searchSeed() depends on besides the seed and frame range
+    virtual u64 getIndexKey() const = 0;
+
+    // Identifies everything getInitialSeed() depends on besides the epoch, searchers with equal keys get equal seeds
+    virtual u64 getSeedKey() const = 0;
+
+    // A filter that isn't null replaces the searcher's own, the result cache searches with a widened one
+    virtual void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *filter, std::vector<ResultType> &hits) = 0;
+
+    // Searchers that support the result cache return everything besides the filter, seed function and ranges that
+    // decides which frames are hits, 0 disables the cache. The filter hooks are only used when the key isn't 0.
+    virtual u64 getCacheKey() const
+    {
+        return 0;
+    }
+
+    virtual std::unique_ptr<ResultFilter> getFilter() const
+    {
+        return nullptr;
+    }
+
+    virtual bool compare(const ResultFilter &, const ResultType &) const
+    {
+        return true;
+    }
+
+private:
+    SeedIndex seedIndex;
+    u64 epochEnd;
+    u32 slices;
+    TraceRecorder trace;
+    std::string tracePath;
+    std::function<void(const std::vector<ResultType> &)> resultCallback;
+
+    std::shared_ptr<ResultCache<ResultType>> resultCache;
+    std::unique_ptr<ResultFilter> outputFilter, cacheFilter;
+    std::vector<ResultType> cacheResults;
+    bool caching;
+    u64 cacheKey;
+
+    std::shared_ptr<SearchCoverage> coverage;
+    bool incremental;
+    u64 incrementalSeconds;
+
+    SearchJournal journal;
+    std::string journalPath;
+    u64 journalKey;
+
+    // Ordered searches key each hit by its epoch, or by its distance to the anchor, and publish it once every tile
+    // that could hold a hit of a smaller key has finished
+    struct OrderedHit
+    {
+        u64 key;
+        u64 epoch;
+        ResultType result;
+    };
+
+    TimeMask timeMask;
+
+    std::shared_ptr<SearchHistogram> histogram;
+    std::vector<SearchHistogram> workerHistograms;
+
+    u32 resultLimit;
+    bool anchored;
+    u64 anchorEpoch, anchorRadius;
+    std::atomic<u64> limitKey;
+    std::priority_queue<u64> limitKeys;
+    std::vector<OrderedHit> orderHits;
+    std::vector<u64> tileKeys;
+    std::vector<bool> tileFinished;
+    size_t tileFrontier;
+    u32 orderPublished;
+
+    // Workers beyond the number of counters share them, the counters stay correct but may contend
+    std::array<SearchCounters, 64> counters;
+    std::atomic<std::chrono::steady_clock::rep> startClock, stopClock, pausedClock;
+
+    void startCounters()
+    {
+        for (auto &counter : counters)
+        {
+            counter.reset();
+        }
+        stopClock = 0;
+        startClock = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    void stopCounters()
+    {
+        pausedClock = control.getPausedTime().count();
+        stopClock = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    // Answers the search from the cache when it covers it and returns true, otherwise sets up the search to fill the
+    // cache. Only the IV ranges are searched when the cache can hold the expected hits of that, so later changes to
+    // the rest of the filter hit the cache too. A seed index skips seeds by the full filter, which rules widening out.
+    // The widened filter is handed to searchSeed() and the searcher's own filter is never changed, the index, journal
+    // and coverage keys all depend on it.
+    bool startCache(int threads)
+    {
+        caching = false;
+        u64 key = resultCache && !isOrdered() && !histogram ? getCacheKey() : 0;
+        if (key == 0)
+        {
+            return false;
+        }
+
+        u64 epochStart = Utility::getCitraTime(startTime, offset);
+        u64 epochEnd = Utility::getCitraTime(endTime, offset);
+
+        Hash hash;
+        hash.add(key).add(getSeedKey()).add(epochStart).add(epochEnd).add(startFrame).add(endFrame).add(offset).add(offsetDeltas);
+        hash.add(timeMask.getKey());
+        cacheKey = hash.get();
+
+        std::unique_ptr<ResultFilter> filter = getFilter();
+        if (resultCache->covers(cacheKey, *filter))
+        {
+            auto hits = resultCache->scan([this, &filter](const ResultType &result) { return compare(*filter, result); }, threads);
+
+            slices = 1;
+            counters[0].progress = getMaxProgress();
+            counters[0].hits = hits.size();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (resultCallback)
+            {
+                resultCallback(hits);
+            }
+            else
+            {
+                results.insert(results.end(), hits.begin(), hits.end());
+            }
+            return true;
+        }
+
+        u64 seconds = (epochEnd - epochStart) / 1000 + 1;
+        double frames = static_cast<double>(endFrame) - startFrame + 1;
+
+        cacheFilter = getFilter();
+        cacheFilter->widen();
+        if (!seedIndex.isOpen() && seconds * offsetDeltas.size() * frames * cacheFilter->getIVShare() <= resultCache->getMaximumResults())
+        {
+            outputFilter = std::move(filter);
+        }
+        else
+        {
+            cacheFilter = std::move(filter);
+        }
+
+        cacheResults.clear();
+        caching = true;
+        return false;
+    }
+
+    // Called with the results lock held for the results a worker just published
+    void cacheHits(size_t previous)
+    {
+        if (caching)
+        {
+            if (cacheResults.size() + (results.size() - previous) > resultCache->getMaximumResults())
+            {
+                caching = false;
+                cacheResults = std::vector<ResultType>();
+            }
+            else
+            {
+                cacheResults.insert(cacheResults.end(), results.begin() + previous, results.end());
+            }
+        }
+
+        if (outputFilter)
+        {
+            auto it = std::remove_if(results.begin() + previous, results.end(),
+                                     [this](const ResultType &result) { return !compare(*outputFilter, result); });
+            results.erase(it, results.end());
+        }
+    }
+
+    void finishCache()
+    {
+        // A cancelled search didn't see every frame
+        if (caching && !control.isCancelled())
+        {
+            resultCache->store(cacheKey, std::move(cacheFilter), std::move(cacheResults));
+        }
+        caching = false;
+        outputFilter.reset();
+        cacheFilter.reset();
+        cacheResults = std::vector<ResultType>();
+    }
+
+    SearchTile getRange() const
+    {
+        return { Utility::getCitraTime(startTime, offset), Utility::getCitraTime(endTime, offset), startFrame, endFrame };
+    }
+
+    // Ranges longer than the seed period repeat hits onto later dates instead of searching them, they are never extended
+    u64 getCoverageKey() const
+    {
+        SearchTile range = getRange();
+        if (seedPeriod != 0 && (range.epochEnd - range.epochStart) / 1000 + 1 > seedPeriod)
+        {
+            return 0;
+        }
+
+        Hash hash;
+        hash.add(getIndexKey()).add(getSeedKey()).add(offset).add(offsetDeltas);
+        return hash.get();
+    }
+
+    void finishCoverage()
+    {
+        if (coverage)
+        {
+            // A cancelled, ordered or masked search leaves holes and a counting search has no results to add to, the
+            // next search starts over
+            if (!control.isCancelled() && !isOrdered() && !timeMask.isEnabled() && !histogram)
+            {
+                coverage->store(getCoverageKey(), getRange());
+            }
+            else
+            {
+                coverage->clear();
+            }
+        }
+    }
+
+    u64 getJournalKey() const
+    {
+        SearchTile range = getRange();
+        Hash hash;
+        hash.add(getIndexKey()).add(getSeedKey()).add(range.epochStart).add(range.epochEnd).add(startFrame).add(endFrame).add(offset);
+        hash.add(offsetDeltas).add(seedPeriod).add(timeMask.getKey());
+        return hash.get();
+    }
+
+    // Incremental searches depend on the coverage of the form, ordered searches don't finish every tile and counting
+    // searches have no results to resume with, none of them keeps a journal
+    bool isJournaling() const
+    {
+        return !incremental && !isOrdered() && !histogram && !journalPath.empty();
+    }
+
+    bool loadJournal(int &tileThreads)
+    {
+        journalKey = getJournalKey();
+        if (!isJournaling() || !journal.load(journalPath, journalKey, sizeof(ResultType)))
+        {
+            return false;
+        }
+        tileThreads = static_cast<int>(journal.getTileThreads());
+        return true;
+    }
+
+    // Publishes the results of the tiles a loaded journal finished, otherwise starts a new journal
+    void startJournal(const std::vector<SearchTile> &tiles, int tileThreads)
+    {
+        static_assert(std::is_trivially_copyable_v<ResultType>, "Results are journaled as raw bytes");
+
+        if (!isJournaling())
+        {
+            return;
+        }
+
+        if (!journal.isOpen() || journal.getTileCount() != tiles.size())
+        {
+            journal.create(journalPath, journalKey, sizeof(ResultType), tileThreads, static_cast<u32>(tiles.size()));
+            return;
+        }
+
+        std::vector<u8> data = journal.takeResults();
+        std::vector<ResultType> saved(data.size() / sizeof(ResultType));
+        std::memcpy(saved.data(), data.data(), saved.size() * sizeof(ResultType));
+
+        for (u32 i = 0; i < tiles.size(); i++)
+        {
+            if (journal.isFinished(i))
+            {
+                counters[0].progress += (tiles[i].epochEnd - tiles[i].epochStart) / 1000 + 1;
+            }
+        }
+        counters[0].hits += saved.size();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (resultCallback)
+        {
+            resultCallback(saved);
+        }
+        else
+        {
+            results.insert(results.end(), saved.begin(), saved.end());
+        }
+    }
+
+    // A cancelled search keeps its journal so it can be resumed
+    void finishJournal()
+    {
+        if (journal.isOpen())
+        {
+            if (!control.isCancelled())
+            {
+                journal.finish();
+            }
+            else
+            {
+                journal.close();
+            }
+        }
+    }
+
+    bool isOrdered() const
+    {
+        return resultLimit != 0 || anchored;
+    }
+
+    // The seconds within the radius of the anchor, the start is after the end when there are none
+    SearchTile getAnchorRange() const
+    {
+        SearchTile range = getRange();
+        if (anchorRadius != 0)
+        {
+            u64 radius = anchorRadius * 1000;
+            range.epochStart = std::max(range.epochStart, anchorEpoch - std::min(anchorEpoch, radius));
+            range.epochEnd = std::min(range.epochEnd, anchorEpoch + radius);
+        }
+        return range;
+    }
+
+    u64 getOrderKey(u64 epoch) const
+    {
+        if (!anchored)
+        {
+            return epoch;
+        }
+        return epoch > anchorEpoch ? epoch - anchorEpoch : anchorEpoch - epoch;
+    }
+
+    // The smallest key of any second of the tile
+    u64 getTileKey(const SearchTile &tile) const
+    {
+        if (anchored && tile.epochEnd < anchorEpoch)
+        {
+            return getOrderKey(tile.epochEnd);
+        }
+        return getOrderKey(anchored ? std::max(tile.epochStart, anchorEpoch) : tile.epochStart);
+    }
+
+    void startOrder(const std::vector<SearchTile> &tiles)
+    {
+        limitKey = std::numeric_limits<u64>::max();
+        limitKeys = std::priority_queue<u64>();
+        orderHits.clear();
+        tileKeys.clear();
+        for (const auto &tile : tiles)
+        {
+            tileKeys.emplace_back(getTileKey(tile));
+        }
+        tileFinished.assign(tiles.size(), false);
+        tileFrontier = 0;
+        orderPublished = 0;
+    }
+
+    // Called with the results lock held, moves the results a worker just published aside until they can be published
+    // in order. Hits repeated onto later seed periods follow the hits of the searched second in blocks of the same size.
+    void orderResults(size_t previous, u64 epoch, size_t count)
+    {
+        for (size_t i = previous; i < results.size(); i++)
+        {
+            u64 hitEpoch = epoch + (i - previous) / count * seedPeriod * 1000;
+            u64 key = getOrderKey(hitEpoch);
+            orderHits.push_back({ key, hitEpoch, results[i] });
+            if (resultLimit != 0)
+            {
+                limitKeys.push(key);
+                if (limitKeys.size() > resultLimit)
+                {
+                    limitKeys.pop();
+                }
+            }
+        }
+        results.erase(results.begin() + previous, results.end());
+
+        if (resultLimit != 0 && limitKeys.size() == resultLimit)
+        {
+            u64 last = limitKeys.top();
+            limitKey = last;
+            if (orderHits.size() >= 2 * static_cast<size_t>(resultLimit))
+            {
+                auto it = std::remove_if(orderHits.begin(), orderHits.end(), [last](const OrderedHit &hit) { return hit.key > last; });
+                orderHits.erase(it, orderHits.end());
+            }
+        }
+    }
+
+    // Called with the results lock held, publishes the hits with a key below the key in order. Hits of the same key
+    // are ordered by date, offset delta and frame.
+    void publishOrder(u64 key)
+    {
+        auto end = std::partition(orderHits.begin(), orderHits.end(), [key](const OrderedHit &hit) { return hit.key < key; });
+        std::sort(orderHits.begin(), end, [](const OrderedHit &left, const OrderedHit &right) {
+            return std::make_tuple(left.key, left.epoch, left.result.getOffsetDelta(), left.result.getFrame())
+                < std::make_tuple(right.key, right.epoch, right.result.getOffsetDelta(), right.result.getFrame());
+        });
+
+        std::vector<ResultType> hits;
+        for (auto it = orderHits.begin(); it != end && (resultLimit == 0 || orderPublished < resultLimit); ++it, orderPublished++)
+        {
+            hits.emplace_back(it->result);
+        }
+        orderHits.erase(orderHits.begin(), end);
+
+        if (resultCallback && !hits.empty())
+        {
+            resultCallback(hits);
+        }
+        else
+        {
+            results.insert(results.end(), hits.begin(), hits.end());
+        }
+    }
+
+    // Tiles are sorted by their smallest key, hits below the key of the first unfinished tile are final
+    void finishTile(size_t index)
+    {
+        if (!isOrdered())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        tileFinished[index] = true;
+        while (tileFrontier < tileFinished.size() && tileFinished[tileFrontier])
+        {
+            tileFrontier++;
+        }
+        if (tileFrontier < tileKeys.size())
+        {
+            publishOrder(tileKeys[tileFrontier]);
+        }
+    }
+
+    // Publishes what is left, a cancelled search publishes the hits it found in order even though closer ones may
+    // have been missed
+    void finishOrder()
+    {
+        if (!isOrdered())
+        {
+            return;
+        }
+
+        // Every second that was skipped is past the last hit
+        if (!control.isCancelled())
+        {
+            u64 progress = 0;
+            for (const auto &counter : counters)
+            {
+                progress += counter.progress.load(std::memory_order_relaxed);
+            }
+            counters[0].progress += getMaxProgress() * slices - std::min<u64>(progress, getMaxProgress() * slices);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        publishOrder(std::numeric_limits<u64>::max());
+        orderHits = std::vector<OrderedHit>();
+    }
+
+    // Counts the hits of a second and the later dates they repeat onto into the histogram of the worker
+    void countHits(SearchHistogram &counts, const std::vector<ResultType> &hits, u64 epoch, SearchCounters &counter)
+    {
+        STAGE_TIMER(Stage::Publish);
+        u64 repeats = 1;
+        if (seedPeriod != 0 && epochEnd > epoch)
+        {
+            repeats += (epochEnd - epoch) / (seedPeriod * 1000);
+        }
+
+        for (u64 i = 0; i < repeats; i++)
+        {
+            u64 time = Utility::getNormalTime(epoch + i * seedPeriod * 1000, offset) / 1000;
+            for (const auto &hit : hits)
+            {
+                counts.add(time, hit.getFrame(), hit.getSeed(), hit.getOffsetDelta());
+            }
+        }
+        counter.hits.fetch_add(hits.size() * repeats, std::memory_order_relaxed);
+    }
+
+    void finishHistogram()
+    {
+        if (histogram)
+        {
+            histogram->clear();
+            for (const auto &counts : workerHistograms)
+            {
+                histogram->merge(counts);
+            }
+        }
+        workerHistograms.clear();
+    }
+
+    // Splits the search into (epoch, frame) tiles. Frame ranges of a single seed are only split when there are
+    // too few seconds to give every thread work, each slice then jumps its RNG ahead to the start of the slice.
+    // Ranges longer than the seed period only search the first period, hits are then repeated onto later dates.
+    // Incremental searches tile each missing part on its own and never split frames. Masked searches tile each run of
+    // allowed seconds on its own. Anchored searches tile each side of the anchor on its own and sort the tiles by
+    // distance to it. Neither repeats hits.
+    std::vector<SearchTile> getTiles(int threads)
+    {
+        constexpr u64 minimumSliceFrames = 50000;
+        constexpr u64 maximumTileSeconds = 86400;
+        constexpr u64 maximumOrderTileSeconds = 3600;
+
+        SearchTile range = getRange();
+        epochEnd = range.epochEnd;
+        u64 tileTarget = static_cast<u64>(threads) * 8;
+
+        // Ordered searches want the first seconds first, small tiles keep threads from running far ahead of them
+        u64 maximumSeconds = isOrdered() ? maximumOrderTileSeconds : maximumTileSeconds;
+
+        slices = 1;
+        std::vector<SearchTile> parts;
+        if (incremental)
+        {
+            parts = coverage->getMissing(range);
+            for (const auto &part : parts)
+            {
+                incrementalSeconds += (part.epochEnd - part.epochStart) / 1000 + 1;
+            }
+        }
+        else
+        {
+            if (anchored)
+            {
+                range = getAnchorRange();
+                if (range.epochStart > range.epochEnd)
+                {
+                    return {};
+                }
+            }
+
+            // Masked and anchored searches search every second they keep, hits repeated onto later dates would ignore
+            // the mask and the order
+            bool masked = timeMask.isEnabled();
+            std::vector<std::pair<u64, u64>> runs = { { range.epochStart, range.epochEnd } };
+            if (masked)
+            {
+                runs = timeMask.getRuns(range.epochStart, range.epochEnd, offset);
+            }
+            if (masked || anchored)
+            {
+                epochEnd = 0;
+            }
+
+            u64 seconds = 0;
+            for (const auto &run : runs)
+            {
+                seconds += (run.second - run.first) / 1000 + 1;
+            }
+            if (!masked && !anchored && seedPeriod != 0 && seconds > seedPeriod)
+            {
+                seconds = seedPeriod;
+                runs.front().second = range.epochStart + (seedPeriod - 1) * 1000;
+            }
+            if (seconds == 0)
+            {
+                return {};
+            }
+
+            u64 frames = static_cast<u64>(endFrame) - startFrame + 1;
+            if (seconds < tileTarget)
+            {
+                slices = static_cast<u32>(std::min((tileTarget + seconds - 1) / seconds, std::max<u64>(frames / minimumSliceFrames, 1)));
+            }
+
+            for (const auto &run : runs)
+            {
+                if (anchored && run.first < anchorEpoch && run.second >= anchorEpoch)
+                {
+                    parts.push_back({ run.first, anchorEpoch - 1000, range.frameStart, range.frameEnd });
+                    parts.push_back({ anchorEpoch, run.second, range.frameStart, range.frameEnd });
+                }
+                else
+                {
+                    parts.push_back({ run.first, run.second, range.frameStart, range.frameEnd });
+                }
+            }
+        }
+
+        // Tiles are sized by all the seconds searched so small parts don't end up as many tiny tiles
+        u64 seconds = 0;
+        for (const auto &part : parts)
+        {
+            seconds += (part.epochEnd - part.epochStart) / 1000 + 1;
+        }
+        u64 tileSeconds = std::clamp<u64>(seconds * slices / tileTarget, 1, maximumSeconds);
+
+        std::vector<SearchTile> tiles;
+        for (const auto &part : parts)
+        {
+            u64 sliceFrames = (static_cast<u64>(part.frameEnd) - part.frameStart + 1) / slices;
+
+            for (u64 epoch = part.epochStart; epoch <= part.epochEnd; epoch += tileSeconds * 1000)
+            {
+                u64 tileEnd = std::min(epoch + (tileSeconds - 1) * 1000, part.epochEnd);
+                for (u32 slice = 0; slice < slices; slice++)
+                {
+                    u32 frameStart = static_cast<u32>(part.frameStart + slice * sliceFrames);
+                    u32 frameEnd = slice == slices - 1 ? part.frameEnd : static_cast<u32>(frameStart + sliceFrames - 1);
+                    tiles.push_back({ epoch, tileEnd, frameStart, frameEnd });
+                }
+            }
+        }
+
+        if (anchored)
+        {
+            std::stable_sort(tiles.begin(), tiles.end(),
+                             [this](const SearchTile &left, const SearchTile &right) { return getTileKey(left) < getTileKey(right); });
+        }
+        return tiles;
+    }
+
+    // Everything the tile publishes is also appended to published when it isn't null
+    void search(const SearchTile &tile, SearchCounters &counter, u32 worker, std::vector<ResultType> *published)
+    {
+        // Seeds are computed for a batch of seconds and every offset delta at once
+        constexpr u64 batchSeconds = 64;
+
+        std::vector<ResultType> hits;
+        std::vector<u64> epochs;
+        std::vector<u32> seeds;
+        u64 frames = static_cast<u64>(tile.frameEnd) - tile.frameStart + 1;
+
+        // A widening result cache searches with its own filter and cacheHits() applies the searcher's to the output
+        const ResultFilter *filter = outputFilter ? cacheFilter.get() : nullptr;
+
+        DateTime target(Utility::getNormalTime(tile.epochStart, offset));
+        for (u64 batch = tile.epochStart; batch <= tile.epochEnd && control.poll(); batch += batchSeconds * 1000)
+        {
+            u64 batchEnd = std::min(batch + (batchSeconds - 1) * 1000, tile.epochEnd);
+
+            // Ordered searches skip seconds after the last of the hits they keep
+            if (getTileKey({ batch, batchEnd, 0, 0 }) > limitKey.load(std::memory_order_relaxed))
+            {
+                target.addSeconds(static_cast<int>((batchEnd - batch) / 1000 + 1));
+                continue;
+            }
+
+            epochs.clear();
+            for (u64 epoch = batch; epoch <= batchEnd; epoch += 1000)
+            {
+                for (int delta : offsetDeltas)
+                {
+                    epochs.emplace_back(epoch + delta);
+                }
+            }
+            seeds.resize(epochs.size());
+            {
+                STAGE_TIMER(Stage::SeedHash);
+                getInitialSeeds(epochs.data(), static_cast<u32>(epochs.size()), seeds.data());
+            }
+
+            trace.instant(worker, "Cancel check", "searching", !control.isCancelled());
+
+            const u32 *seed = seeds.data();
+            for (u64 epoch = batch; epoch <= batchEnd && control.poll(); epoch += 1000, target.addSeconds(1))
+            {
+                if (getOrderKey(epoch) > limitKey.load(std::memory_order_relaxed))
+                {
+                    seed += offsetDeltas.size();
+                    continue;
+                }
+
+                // Hits of a second are kept together, each tagged with the delta that produced it
+                for (int delta : offsetDeltas)
+                {
+                    u32 initialSeed = *seed++;
+                    size_t previous = hits.size();
+                    if (!seedIndex.isOpen() || seedIndex.test(initialSeed))
+                    {
+                        searchSeed(initialSeed, tile.frameStart, tile.frameEnd, filter, hits);
+                        counter.frames.fetch_add(frames, std::memory_order_relaxed);
+                    }
+
+                    for (size_t i = previous; i < hits.size(); i++)
+                    {
+                        hits[i].setTarget(target, delta);
+                    }
+                }
+
+                counter.seeds.fetch_add(offsetDeltas.size(), std::memory_order_relaxed);
+                if (histogram && !hits.empty())
+                {
+                    countHits(workerHistograms[worker], hits, epoch, counter);
+                    hits.clear();
+                }
+                if (!hits.empty())
+                {
+                    STAGE_TIMER(Stage::Publish);
+                    u64 flushStart = trace.now();
+                    std::lock_guard<std::mutex> lock(mutex);
+                    size_t previous = results.size();
+                    results.insert(results.end(), hits.begin(), hits.end());
+
+                    if (seedPeriod != 0)
+                    {
+                        for (u64 repeat = epoch + seedPeriod * 1000; repeat <= epochEnd; repeat += seedPeriod * 1000)
+                        {
+                            DateTime repeatTarget(Utility::getNormalTime(repeat, offset));
+                            for (auto hit : hits)
+                            {
+                                hit.setTarget(repeatTarget, hit.getOffsetDelta());
+                                results.emplace_back(hit);
+                            }
+                        }
+                    }
+                    cacheHits(previous);
+                    if (published)
+                    {
+                        published->insert(published->end(), results.begin() + previous, results.end());
+                    }
+                    counter.hits.fetch_add(results.size() - previous, std::memory_order_relaxed);
+                    trace.complete(worker, "Flush results", flushStart, trace.now(), "results", results.size() - previous);
+
+                    if (isOrdered())
+                    {
+                        orderResults(previous, epoch, hits.size());
+                    }
+
+                    if (resultCallback && results.size() > previous)
+                    {
+                        resultCallback(std::vector<ResultType>(results.begin() + previous, results.end()));
+                        results.erase(results.begin() + previous, results.end());
+                    }
+                    hits.clear();
+                }
+                counter.progress.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+#endif // SEARCHER_HPP
@@ -19,6 +19,7 @@
 
 #include "StationaryFilter.hpp"
 #include <Core/Parents/StationaryResult.hpp>
+#include <Core/Util/StageTimer.hpp>
 
 StationaryFilter::StationaryFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                                    const std::vector<bool> &hiddenPower, u8 ability, u8 shiny, u8 gender) :
@@ -26,8 +27,10 @@ StationaryFilter::StationaryFilter(const std::array<u8, 6> &minIV, const std::ar
 {
 }
 
-bool StationaryFilter::compare(const StationaryResult &frame)
+bool StationaryFilter::compare(const StationaryResult &frame) const
 {
+    STAGE_TIMER(Stage::Filter);
+
     if (shiny != 255 && !(shiny & frame.getShiny()))
     {
         return false;
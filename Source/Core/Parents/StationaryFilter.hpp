@@ -29,7 +29,7 @@ class StationaryFilter : public ResultFilter
 public:
     StationaryFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                      const std::vector<bool> &hiddenPower, u8 ability, u8 shiny, u8 gender);
-    bool compare(const StationaryResult &frame);
+    bool compare(const StationaryResult &frame) const;
 };
 
 #endif // STATIONARYFILTER_HPP
@@ -27,10 +27,21 @@ class StationaryResult : public Result
 public:
     StationaryResult() = default;
 
-    StationaryResult(u32 seed, u16 tid, u16 sid) : Result(seed, tid, sid)
+    StationaryResult(u32 seed, u16 tid, u16 sid) : Result(seed, tid, sid), encounter(0)
     {
     }
 
+    // Index of the target that matched when the searcher was given several
+    u16 getEncounter() const
+    {
+        return encounter;
+    }
+
+    void setEncounter(u16 encounter)
+    {
+        this->encounter = encounter;
+    }
+
     bool getSynch() const
     {
         return synch;
@@ -43,6 +54,7 @@ public:
 
 private:
     bool synch;
+    u16 encounter;
 };
 
 #endif // STATIONARYRESULT_HPP
@@ -0,0 +1,45 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef STATIONARYTARGET_HPP
+#define STATIONARYTARGET_HPP
+
+#include <Core/Parents/StationaryFilter.hpp>
+
+// Encounter parameters and filter of one of the targets a stationary searcher checks on every frame
+struct StationaryTarget
+{
+    StationaryTarget(bool ivCount, u8 ability, u8 synchNature, u8 gender, bool alwaysSynch, bool shinyLocked,
+                     const StationaryFilter &filter) :
+        filter(filter),
+        ivCount(ivCount ? 3 : 0),
+        ability(ability),
+        synchNature(synchNature),
+        gender(gender),
+        alwaysSynch(alwaysSynch),
+        shinyLocked(shinyLocked)
+    {
+    }
+
+    StationaryFilter filter;
+    u8 ivCount, ability, synchNature, gender;
+    bool alwaysSynch, shinyLocked;
+};
+
+#endif // STATIONARYTARGET_HPP
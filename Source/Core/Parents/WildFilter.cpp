@@ -18,6 +18,7 @@
  */
 #include "WildFilter.hpp"
 #include <Core/Parents/WildResult.hpp>
+#include <Core/Util/StageTimer.hpp>
 
 WildFilter::WildFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                        const std::vector<bool> &hiddenPower, const std::vector<bool> &encounterSlots, u8 ability, u8 shiny, u8 gender) :
@@ -25,8 +26,35 @@ WildFilter::WildFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &
 {
 }
 
-bool WildFilter::compare(const WildResult &frame)
+void WildFilter::addHash(Hash &hash) const
 {
+    ResultFilter::addHash(hash);
+    hash.add(encounterSlots);
+}
+
+bool WildFilter::contains(const ResultFilter &other) const
+{
+    auto &wild = static_cast<const WildFilter &>(other);
+    for (size_t i = 0; i < encounterSlots.size(); i++)
+    {
+        if (wild.encounterSlots[i] && !encounterSlots[i])
+        {
+            return false;
+        }
+    }
+    return ResultFilter::contains(other);
+}
+
+void WildFilter::widen()
+{
+    ResultFilter::widen();
+    std::fill(encounterSlots.begin(), encounterSlots.end(), true);
+}
+
+bool WildFilter::compare(const WildResult &frame) const
+{
+    STAGE_TIMER(Stage::Filter);
+
     if (shiny != 255 && !(shiny & frame.getShiny()))
     {
         return false;
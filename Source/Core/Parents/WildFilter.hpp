@@ -29,7 +29,10 @@ class WildFilter : public ResultFilter
 public:
     WildFilter(const std::array<u8, 6> &minIV, const std::array<u8, 6> &maxIV, const std::vector<bool> &nature,
                const std::vector<bool> &hiddenPower, const std::vector<bool> &encounterSlots, u8 ability, u8 shiny, u8 gender);
-    bool compare(const WildResult &frame);
+    bool compare(const WildResult &frame) const;
+    void addHash(Hash &hash) const;
+    bool contains(const ResultFilter &other) const override;
+    void widen() override;
 
 private:
     std::vector<bool> encounterSlots;
@@ -0,0 +1,237 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "Wondercard.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    u16 readU16(const u8 *data)
+    {
+        return static_cast<u16>(data[0] | (data[1] << 8));
+    }
+
+    u32 readU32(const u8 *data)
+    {
+        return static_cast<u32>(data[0]) | (static_cast<u32>(data[1]) << 8) | (static_cast<u32>(data[2]) << 16)
+            | (static_cast<u32>(data[3]) << 24);
+    }
+}
+
+Wondercard::Wondercard(const std::string &path) : name(std::filesystem::path(path).filename().string())
+{
+    std::ifstream read(path, std::ios::binary);
+    if (!read.is_open())
+    {
+        error = "There was a problem opening the wondercard";
+        return;
+    }
+
+    std::vector<u8> data((std::istreambuf_iterator<char>(read)), std::istreambuf_iterator<char>());
+    parse(data);
+}
+
+Wondercard::Wondercard(const std::vector<u8> &data, const std::string &name) : name(name)
+{
+    parse(data);
+}
+
+std::vector<Wondercard> Wondercard::loadDirectory(const std::string &directory, u8 generation)
+{
+    std::string extension = ".wc" + std::to_string(generation);
+
+    std::vector<std::string> paths;
+    std::error_code code;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, code))
+    {
+        std::string fileExtension = entry.path().extension().string();
+        std::transform(fileExtension.begin(), fileExtension.end(), fileExtension.begin(), ::tolower);
+        if (entry.is_regular_file(code) && (fileExtension == extension || fileExtension == extension + "full"))
+        {
+            paths.emplace_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<Wondercard> cards;
+    for (const auto &path : paths)
+    {
+        cards.emplace_back(path);
+    }
+    return cards;
+}
+
+bool Wondercard::isValid() const
+{
+    return error.empty();
+}
+
+const std::string &Wondercard::getError() const
+{
+    return error;
+}
+
+const std::string &Wondercard::getName() const
+{
+    return name;
+}
+
+u8 Wondercard::getIVCount() const
+{
+    return ivCount;
+}
+
+std::array<u8, 6> Wondercard::getIVTemplate() const
+{
+    return ivTemplate;
+}
+
+PIDType Wondercard::getPIDType() const
+{
+    return pidType;
+}
+
+u32 Wondercard::getPID() const
+{
+    return pid;
+}
+
+u32 Wondercard::getEC() const
+{
+    return ec;
+}
+
+bool Wondercard::getAbilityLocked() const
+{
+    return abilityLocked;
+}
+
+u8 Wondercard::getAbility() const
+{
+    return ability;
+}
+
+bool Wondercard::getNatureLocked() const
+{
+    return natureLocked;
+}
+
+u8 Wondercard::getNature() const
+{
+    return nature;
+}
+
+bool Wondercard::getGenderLocked() const
+{
+    return genderLocked;
+}
+
+u8 Wondercard::getGender() const
+{
+    return gender;
+}
+
+u16 Wondercard::getTID() const
+{
+    return tid;
+}
+
+u16 Wondercard::getSID() const
+{
+    return sid;
+}
+
+bool Wondercard::getOwnID() const
+{
+    return ownID;
+}
+
+bool Wondercard::getEgg() const
+{
+    return egg;
+}
+
+void Wondercard::parse(const std::vector<u8> &file)
+{
+    if (file.size() != 784 && file.size() != 264)
+    {
+        error = "Invalid format for wondercard";
+        return;
+    }
+
+    const u8 *data = file.data() + (file.size() == 784 ? 520 : 0);
+    if (data[0x51] != 0)
+    {
+        error = "Invalid wondercard type";
+        return;
+    }
+    if (data[0xA3] > 3)
+    {
+        error = "Invalid PID type in wondercard";
+        return;
+    }
+
+    // Locked abilities map to 1, 2 and H, unlocked ones to 1/2 and 1/2/H
+    abilityLocked = data[0xA2] < 3;
+    ability = abilityLocked ? data[0xA2] + 1 : data[0xA2] - 3;
+
+    natureLocked = data[0xA0] != 0xFF;
+    nature = natureLocked ? data[0xA0] : 0;
+
+    genderLocked = data[0xA1] != 3;
+    gender = genderLocked ? (data[0xA1] + 1) % 3 : 0;
+
+    // Cards store IVs in HP, Atk, Def, Spe, SpA, SpD order. 0xFC-0xFE mean 1-3 random IVs are guaranteed to be 31.
+    std::array<u8, 6> ivs;
+    std::array<u8, 6> order = { 0, 1, 2, 4, 5, 3 };
+    for (size_t i = 0; i < 6; i++)
+    {
+        ivs[i] = data[0xAF + order[i]];
+    }
+
+    u8 ivFlag = 0;
+    for (u8 iv : ivs)
+    {
+        if (iv >= 0xFC && iv <= 0xFE)
+        {
+            ivFlag = iv;
+            break;
+        }
+    }
+
+    ivCount = ivFlag == 0 ? 0 : ivFlag - 0xFB;
+    for (size_t i = 0; i < 6; i++)
+    {
+        ivTemplate[i] = ivFlag == 0 && ivs[i] <= 31 ? ivs[i] : 255;
+    }
+
+    tid = readU16(data + 0x68);
+    sid = readU16(data + 0x6A);
+    ownID = data[0xB5] == 3;
+    egg = data[0xD1] == 1;
+
+    constexpr PIDType typeOrder[4] = { PIDType::Specified, PIDType::Random, PIDType::Shiny, PIDType::Nonshiny };
+    pidType = typeOrder[data[0xA3]];
+    pid = pidType == PIDType::Specified ? readU32(data + 0xD4) : 0;
+    ec = readU32(data + 0x70);
+}
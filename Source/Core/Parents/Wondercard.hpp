@@ -0,0 +1,75 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef WONDERCARD_HPP
+#define WONDERCARD_HPP
+
+#include <Core/Util/Global.hpp>
+#include <Core/Util/PIDType.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+// Event parameters of a wc6/wc7 wondercard, both generations share the card layout. Values use the encoding
+// the event searchers and forms expect, so a card can be applied with EventSearcher::setWondercard().
+class Wondercard
+{
+public:
+    // Reads a card file, getError() is set if the file can't be read or doesn't hold a Pokémon
+    explicit Wondercard(const std::string &path);
+
+    // Full files (784 bytes) have a 520 byte header before the 264 byte card
+    Wondercard(const std::vector<u8> &data, const std::string &name);
+
+    // Every .wcN and .wcNfull file of the directory sorted by name, including the ones that failed to parse
+    static std::vector<Wondercard> loadDirectory(const std::string &directory, u8 generation);
+
+    bool isValid() const;
+    const std::string &getError() const;
+    const std::string &getName() const;
+    u8 getIVCount() const;
+    std::array<u8, 6> getIVTemplate() const;
+    PIDType getPIDType() const;
+    u32 getPID() const;
+    u32 getEC() const;
+    bool getAbilityLocked() const;
+    u8 getAbility() const;
+    bool getNatureLocked() const;
+    u8 getNature() const;
+    bool getGenderLocked() const;
+    u8 getGender() const;
+    u16 getTID() const;
+    u16 getSID() const;
+    bool getOwnID() const;
+    bool getEgg() const;
+
+private:
+    std::string name;
+    std::string error;
+    std::array<u8, 6> ivTemplate;
+    PIDType pidType;
+    u32 pid, ec;
+    u16 tid, sid;
+    u8 ivCount, ability, nature, gender;
+    bool abilityLocked, natureLocked, genderLocked, ownID, egg;
+
+    void parse(const std::vector<u8> &data);
+};
+
+#endif // WONDERCARD_HPP
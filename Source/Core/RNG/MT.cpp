@@ -19,9 +19,11 @@
 
 #include "MT.hpp"
 #include <Core/RNG/SIMD.hpp>
+#include <Core/Util/StageTimer.hpp>
 
 MT::MT(u32 seed, u32 frames)
 {
+    STAGE_TIMER(Stage::GeneratorInit);
     initialize(seed);
     advanceFrames(frames);
 }
@@ -67,6 +69,7 @@ u32 MT::next()
 
 void MT::shuffle()
 {
+    STAGE_TIMER(Stage::Shuffle);
     vuint32x4 upperMask = v32x4_set(0x80000000);
     vuint32x4 lowerMask = v32x4_set(0x7fffffff);
     vuint32x4 matrix = v32x4_set(0x9908b0df);
@@ -0,0 +1,116 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef RNGWINDOW_HPP
+#define RNGWINDOW_HPP
+
+#include <Core/Util/Global.hpp>
+#include <Core/Util/SearchControl.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// Generates the values of a seed frame by frame into a buffer that kernels read directly, so several kernels can share
+// one generated stream. The buffer holds a chunk of frames plus enough values after the last frame for it to read.
+template <typename IntegerType, typename RNGType>
+class RNGWindow
+{
+public:
+    static constexpr u32 chunkSize = 1024;
+    static constexpr u32 maximumLookahead = 127;
+
+    RNGWindow(u32 seed, u32 frame, u32 lookahead) : rng(seed, frame), lookahead(std::min(lookahead, maximumLookahead)), previous(0)
+    {
+    }
+
+    RNGWindow(const RNGWindow &) = delete;
+
+    void operator=(const RNGWindow &) = delete;
+
+    // Returns the values starting at the next frame, valid for the next frames (at most chunkSize) plus the lookahead
+    const IntegerType *advance(u32 frames)
+    {
+        u32 kept = 0;
+        if (previous != 0)
+        {
+            std::memmove(values.data(), values.data() + previous, lookahead * sizeof(IntegerType));
+            kept = lookahead;
+        }
+
+        for (u32 i = kept; i < frames + lookahead; i++)
+        {
+            values[i] = rng.next();
+        }
+        previous = frames;
+        return values.data();
+    }
+
+    // Calls kernel(window, frame, count) for every chunk of frames between frameStart and frameEnd. The control is
+    // polled before each chunk, a cancelled search stops after the chunks it already handed to the kernel.
+    template <class Kernel>
+    static void search(u32 seed, u32 frameStart, u32 frameEnd, u32 lookahead, Kernel &&kernel, SearchControl *control = nullptr)
+    {
+        RNGWindow window(seed, frameStart, lookahead);
+        for (u64 frame = frameStart; frame <= frameEnd; frame += chunkSize)
+        {
+            if (control && !control->poll())
+            {
+                return;
+            }
+
+            u32 count = static_cast<u32>(std::min<u64>(chunkSize, frameEnd - frame + 1));
+            kernel(window.advance(count), static_cast<u32>(frame), count);
+        }
+    }
+
+private:
+    RNGType rng;
+    u32 lookahead;
+    u32 previous;
+    std::array<IntegerType, chunkSize + maximumLookahead> values;
+};
+
+// Reads a window the way RNGList reads its circular buffer, values past the size wrap back to the start of the frame
+template <typename IntegerType, u32 size>
+class RNGWindowList
+{
+public:
+    static constexpr u32 lookahead = size - 1;
+
+    explicit RNGWindowList(const IntegerType *values) : values(values), pointer(0)
+    {
+        static_assert(size && ((size & (size - 1)) == 0), "Number is not a perfect multiple of two");
+    }
+
+    void advanceFrames(u32 frames)
+    {
+        pointer += frames;
+    }
+
+    IntegerType getValue()
+    {
+        return values[pointer++ & (size - 1)];
+    }
+
+private:
+    const IntegerType *values;
+    u32 pointer;
+};
+
+#endif // RNGWINDOW_HPP
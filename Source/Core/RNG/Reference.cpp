@@ -0,0 +1,268 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "Reference.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    constexpr u32 sfmtPos1 = 122;
+    constexpr u32 sfmtShiftLeft = 18;
+    constexpr u32 sfmtShiftRight = 11;
+    constexpr u32 sfmtShiftBytes = 1;
+    constexpr u32 sfmtMask[4] = { 0xdfffffef, 0xddfecb7f, 0xbffaffff, 0xbffffff6 };
+    constexpr u32 sfmtParity[4] = { 0x00000001, 0x00000000, 0x00000000, 0x13c9e684 };
+
+    constexpr u32 K[64]
+        = { 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+            0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+            0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+            0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+            0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+            0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+    u32 rotr(u32 value, u32 shift)
+    {
+        return (value >> shift) | (value << (32 - shift));
+    }
+
+    // Shifts a 128 bit value made of four little endian words left by whole bytes
+    void shiftLeft128(u32 *out, const u32 *in, u32 bytes)
+    {
+        u64 high = (static_cast<u64>(in[3]) << 32) | in[2];
+        u64 low = (static_cast<u64>(in[1]) << 32) | in[0];
+        u64 outHigh = (high << (bytes * 8)) | (low >> (64 - bytes * 8));
+        u64 outLow = low << (bytes * 8);
+        out[0] = static_cast<u32>(outLow);
+        out[1] = static_cast<u32>(outLow >> 32);
+        out[2] = static_cast<u32>(outHigh);
+        out[3] = static_cast<u32>(outHigh >> 32);
+    }
+
+    void shiftRight128(u32 *out, const u32 *in, u32 bytes)
+    {
+        u64 high = (static_cast<u64>(in[3]) << 32) | in[2];
+        u64 low = (static_cast<u64>(in[1]) << 32) | in[0];
+        u64 outLow = (low >> (bytes * 8)) | (high << (64 - bytes * 8));
+        u64 outHigh = high >> (bytes * 8);
+        out[0] = static_cast<u32>(outLow);
+        out[1] = static_cast<u32>(outLow >> 32);
+        out[2] = static_cast<u32>(outHigh);
+        out[3] = static_cast<u32>(outHigh >> 32);
+    }
+
+    std::array<u8, 32> sha256(const std::vector<u8> &message)
+    {
+        std::vector<u8> data = message;
+        u64 bits = static_cast<u64>(message.size()) * 8;
+        data.emplace_back(0x80);
+        while (data.size() % 64 != 56)
+        {
+            data.emplace_back(0);
+        }
+        for (int i = 7; i >= 0; i--)
+        {
+            data.emplace_back(static_cast<u8>(bits >> (i * 8)));
+        }
+
+        u32 hash[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+        for (size_t block = 0; block < data.size(); block += 64)
+        {
+            u32 w[64];
+            for (int i = 0; i < 16; i++)
+            {
+                const u8 *word = &data[block + i * 4];
+                w[i] = (static_cast<u32>(word[0]) << 24) | (static_cast<u32>(word[1]) << 16) | (static_cast<u32>(word[2]) << 8) | word[3];
+            }
+            for (int i = 16; i < 64; i++)
+            {
+                u32 sig0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                u32 sig1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + sig0 + w[i - 7] + sig1;
+            }
+
+            u32 a = hash[0], b = hash[1], c = hash[2], d = hash[3], e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+            for (int i = 0; i < 64; i++)
+            {
+                u32 s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+                u32 ch = (e & f) ^ (~e & g);
+                u32 temp1 = h + s1 + ch + K[i] + w[i];
+                u32 s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+                u32 maj = (a & b) ^ (a & c) ^ (b & c);
+                u32 temp2 = s0 + maj;
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c;
+                c = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+
+            hash[0] += a;
+            hash[1] += b;
+            hash[2] += c;
+            hash[3] += d;
+            hash[4] += e;
+            hash[5] += f;
+            hash[6] += g;
+            hash[7] += h;
+        }
+
+        std::array<u8, 32> digest;
+        for (int i = 0; i < 8; i++)
+        {
+            digest[i * 4] = static_cast<u8>(hash[i] >> 24);
+            digest[i * 4 + 1] = static_cast<u8>(hash[i] >> 16);
+            digest[i * 4 + 2] = static_cast<u8>(hash[i] >> 8);
+            digest[i * 4 + 3] = static_cast<u8>(hash[i]);
+        }
+        return digest;
+    }
+}
+
+namespace Reference
+{
+    SFMT::SFMT(u32 seed)
+    {
+        state[0] = seed;
+        for (u32 i = 1; i < 624; i++)
+        {
+            state[i] = 1812433253 * (state[i - 1] ^ (state[i - 1] >> 30)) + i;
+        }
+
+        // Period certification
+        u32 inner = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            inner ^= state[i] & sfmtParity[i];
+        }
+        for (int shift = 16; shift > 0; shift >>= 1)
+        {
+            inner ^= inner >> shift;
+        }
+        if ((inner & 1) == 0)
+        {
+            bool fixed = false;
+            for (int i = 0; i < 4 && !fixed; i++)
+            {
+                for (int bit = 0; bit < 32; bit++)
+                {
+                    if ((sfmtParity[i] >> bit) & 1)
+                    {
+                        state[i] ^= 1u << bit;
+                        fixed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        index = 624;
+    }
+
+    u64 SFMT::next()
+    {
+        if (index >= 624)
+        {
+            generate();
+            index = 0;
+        }
+
+        u32 low = state[index++];
+        u32 high = state[index++];
+        return (static_cast<u64>(high) << 32) | low;
+    }
+
+    void SFMT::generate()
+    {
+        // 156 128 bit words, each r = a ^ (a << 8) ^ ((b >> 11) & mask) ^ (c >> 8) ^ (d << 18) with c and d the two previous outputs
+        for (u32 i = 0; i < 156; i++)
+        {
+            u32 *a = &state[i * 4];
+            const u32 *b = &state[((i + sfmtPos1) % 156) * 4];
+            const u32 *c = &state[((i + 154) % 156) * 4];
+            const u32 *d = &state[((i + 155) % 156) * 4];
+
+            u32 x[4], y[4];
+            shiftLeft128(x, a, sfmtShiftBytes);
+            shiftRight128(y, c, sfmtShiftBytes);
+            for (int j = 0; j < 4; j++)
+            {
+                a[j] = a[j] ^ x[j] ^ ((b[j] >> sfmtShiftRight) & sfmtMask[j]) ^ y[j] ^ (d[j] << sfmtShiftLeft);
+            }
+        }
+    }
+
+    MT::MT(u32 seed)
+    {
+        state[0] = seed;
+        for (u32 i = 1; i < 624; i++)
+        {
+            state[i] = 1812433253 * (state[i - 1] ^ (state[i - 1] >> 30)) + i;
+        }
+        index = 624;
+    }
+
+    u32 MT::next()
+    {
+        if (index >= 624)
+        {
+            generate();
+            index = 0;
+        }
+
+        u32 y = state[index++];
+        y ^= y >> 11;
+        y ^= (y << 7) & 0x9d2c5680;
+        y ^= (y << 15) & 0xefc60000;
+        y ^= y >> 18;
+        return y;
+    }
+
+    void MT::generate()
+    {
+        for (u32 i = 0; i < 624; i++)
+        {
+            u32 y = (state[i] & 0x80000000) | (state[(i + 1) % 624] & 0x7fffffff);
+            state[i] = state[(i + 397) % 624] ^ (y >> 1) ^ ((y & 1) ? 0x9908b0df : 0);
+        }
+    }
+
+    u32 calcInitialSeed(u32 tick, u64 epoch)
+    {
+        std::vector<u8> message(16, 0);
+        for (int i = 0; i < 4; i++)
+        {
+            message[i] = static_cast<u8>(tick >> (i * 8));
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            message[8 + i] = static_cast<u8>(epoch >> (i * 8));
+        }
+
+        std::array<u8, 32> digest = sha256(message);
+        return digest[0] | (static_cast<u32>(digest[1]) << 8) | (static_cast<u32>(digest[2]) << 16) | (static_cast<u32>(digest[3]) << 24);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef REFERENCE_HPP
+#define REFERENCE_HPP
+
+#include <Core/Util/Global.hpp>
+
+// Plain scalar versions of the RNGs and the seed hash written straight from their specifications.
+// They are slow on purpose and only exist to check the optimized kernels against.
+namespace Reference
+{
+    class SFMT
+    {
+    public:
+        explicit SFMT(u32 seed);
+        u64 next();
+
+    private:
+        u32 state[624];
+        u32 index;
+
+        void generate();
+    };
+
+    class MT
+    {
+    public:
+        explicit MT(u32 seed);
+        u32 next();
+
+    private:
+        u32 state[624];
+        u32 index;
+
+        void generate();
+    };
+
+    // SHA-256 of the 16 byte message tick, 0, epoch in little endian, the seed is the first 4 bytes of the digest
+    u32 calcInitialSeed(u32 tick, u64 epoch);
+}
+
+#endif // REFERENCE_HPP
@@ -19,9 +19,11 @@
 
 #include "SFMT.hpp"
 #include <Core/RNG/SIMD.hpp>
+#include <Core/Util/StageTimer.hpp>
 
 SFMT::SFMT(u32 seed, u32 frames)
 {
+    STAGE_TIMER(Stage::GeneratorInit);
     initialize(seed);
     advanceFrames(frames);
 }
@@ -73,6 +75,7 @@ u64 SFMT::next()
 
 void SFMT::shuffle()
 {
+    STAGE_TIMER(Stage::Shuffle);
     vuint32x4 c = v32x4_load(&sfmt[616]);
     vuint32x4 d = v32x4_load(&sfmt[620]);
     vuint32x4 mask = v32x4_set(0xdfffffef, 0xddfecb7f, 0xbffaffff, 0xbffffff6);
@@ -18,6 +18,7 @@
  */
 
 #include "SHA256.hpp"
+#include <Core/RNG/SIMD.hpp>
 #include <bit>
 
 constexpr u32 K[64]
@@ -82,3 +83,75 @@ u32 SHA256::hash(u32 tick, u32 epochLow, u32 epochHigh)
 
     return changeEndian(a + 0x6a09e667);
 }
+
+void SHA256::hash(u32 tick, const u64 *epochs, u32 count, u32 *seeds)
+{
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vuint32x4 w[64];
+        w[0] = v32x4_set(changeEndian(tick));
+        w[1] = v32x4_set(0);
+        w[2] = v32x4_set(changeEndian(static_cast<u32>(epochs[i])), changeEndian(static_cast<u32>(epochs[i + 1])),
+                         changeEndian(static_cast<u32>(epochs[i + 2])), changeEndian(static_cast<u32>(epochs[i + 3])));
+        w[3] = v32x4_set(changeEndian(static_cast<u32>(epochs[i] >> 32)), changeEndian(static_cast<u32>(epochs[i + 1] >> 32)),
+                         changeEndian(static_cast<u32>(epochs[i + 2] >> 32)), changeEndian(static_cast<u32>(epochs[i + 3] >> 32)));
+        w[4] = v32x4_set(0x80000000);
+        for (u8 j = 5; j < 15; j++)
+        {
+            w[j] = v32x4_set(0);
+        }
+        w[15] = v32x4_set(0x80);
+        w[16] = w[0];
+
+        for (u8 j = 17; j < 64; j++)
+        {
+            vuint32x4 sig0 = v32x4_xor(v32x4_xor(v32x4_rotr<7>(w[j - 15]), v32x4_rotr<18>(w[j - 15])), v32x4_shr<3>(w[j - 15]));
+            vuint32x4 sig1 = v32x4_xor(v32x4_xor(v32x4_rotr<17>(w[j - 2]), v32x4_rotr<19>(w[j - 2])), v32x4_shr<10>(w[j - 2]));
+
+            w[j] = v32x4_add(v32x4_add(sig1, w[j - 7]), v32x4_add(sig0, w[j - 16]));
+        }
+
+        vuint32x4 a = v32x4_set(0x6a09e667);
+        vuint32x4 b = v32x4_set(0xbb67ae85);
+        vuint32x4 c = v32x4_set(0x3c6ef372);
+        vuint32x4 d = v32x4_set(0xa54ff53a);
+        vuint32x4 e = v32x4_set(0x510e527f);
+        vuint32x4 f = v32x4_set(0x9b05688c);
+        vuint32x4 g = v32x4_set(0x1f83d9ab);
+        vuint32x4 h = v32x4_set(0x5be0cd19);
+
+        for (u8 j = 0; j < 64; j++)
+        {
+            vuint32x4 s1 = v32x4_xor(v32x4_xor(v32x4_rotr<6>(e), v32x4_rotr<11>(e)), v32x4_rotr<25>(e));
+            vuint32x4 ch = v32x4_xor(g, v32x4_and(e, v32x4_xor(f, g)));
+
+            vuint32x4 temp1 = v32x4_add(v32x4_add(h, s1), v32x4_add(ch, v32x4_add(v32x4_set(K[j]), w[j])));
+
+            vuint32x4 s0 = v32x4_xor(v32x4_xor(v32x4_rotr<2>(a), v32x4_rotr<13>(a)), v32x4_rotr<22>(a));
+            vuint32x4 maj = v32x4_xor(b, v32x4_and(v32x4_xor(a, b), v32x4_xor(b, c)));
+
+            vuint32x4 temp2 = v32x4_add(s0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = v32x4_add(d, temp1);
+            d = c;
+            c = b;
+            b = a;
+            a = v32x4_add(temp1, temp2);
+        }
+
+        v32x4_store(&seeds[i], v32x4_add(a, v32x4_set(0x6a09e667)));
+        for (u8 j = 0; j < 4; j++)
+        {
+            seeds[i + j] = changeEndian(seeds[i + j]);
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        seeds[i] = hash(tick, static_cast<u32>(epochs[i] & 0xffffffff), static_cast<u32>(epochs[i] >> 32));
+    }
+}
@@ -25,6 +25,9 @@
 namespace SHA256
 {
     u32 hash(u32 tick, u32 epochLow, u32 epochHigh);
+
+    // Hashes four epochs at a time with SIMD, results match hash() for each epoch
+    void hash(u32 tick, const u64 *epochs, u32 count, u32 *seeds);
 };
 
 #endif // SHA256_HPP
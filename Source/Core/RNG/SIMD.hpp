@@ -158,6 +158,27 @@ inline vuint32x4 v32x4_or(vuint32x4 x, vuint32x4 y)
 #endif
 }
 
+template <int shift>
+inline vuint32x4 v32x4_rotr(vuint32x4 value)
+{
+    return v32x4_or(v32x4_shr<shift>(value), v32x4_shl<32 - shift>(value));
+}
+
+inline vuint32x4 v32x4_add(vuint32x4 x, vuint32x4 y)
+{
+#if defined(__i386__) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_AMD64)
+    return _mm_add_epi32(x, y);
+#elif defined(__arm__) || defined(_M_ARM) || defined(__aarch64__)
+    return vaddq_u32(x, y);
+#else
+    for (int i = 0; i < 4; i++)
+    {
+        x[i] += y[i];
+    }
+    return x;
+#endif
+}
+
 inline vuint32x4 v32x4_cmpeq(vuint32x4 x, vuint32x4 y)
 {
 #if defined(__i386__) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_AMD64)
@@ -0,0 +1,86 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <Core/Util/Global.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// FNV-1a hash used to identify search configurations, not meant to be cryptographically strong
+class Hash
+{
+public:
+    template <typename T>
+    Hash &add(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        addBytes(&value, sizeof(T));
+        return *this;
+    }
+
+    template <typename T>
+    Hash &add(const std::vector<T> &values)
+    {
+        add(values.size());
+        for (const auto &value : values)
+        {
+            add(value);
+        }
+        return *this;
+    }
+
+    Hash &add(const std::vector<bool> &values)
+    {
+        add(values.size());
+        for (bool value : values)
+        {
+            add(value);
+        }
+        return *this;
+    }
+
+    Hash &add(const std::string &value)
+    {
+        add(value.size());
+        addBytes(value.data(), value.size());
+        return *this;
+    }
+
+    u64 get() const
+    {
+        return value;
+    }
+
+private:
+    u64 value = 0xcbf29ce484222325;
+
+    void addBytes(const void *data, size_t size)
+    {
+        auto *bytes = static_cast<const u8 *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            value = (value ^ bytes[i]) * 0x100000001b3;
+        }
+    }
+};
+
+#endif // HASH_HPP
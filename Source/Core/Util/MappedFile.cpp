@@ -0,0 +1,176 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : file(INVALID_HANDLE_VALUE), mapping(nullptr), data(nullptr), size(0)
+#else
+MappedFile::MappedFile() : file(-1), data(nullptr), size(0)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string &path, bool write)
+{
+    close();
+
+#ifdef _WIN32
+    DWORD access = write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+    file = CreateFileA(path.c_str(), access, write ? 0 : FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER length;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &length))
+    {
+        close();
+        return false;
+    }
+    size = length.QuadPart;
+#else
+    file = ::open(path.c_str(), write ? O_RDWR : O_RDONLY);
+    struct stat info;
+    if (file == -1 || fstat(file, &info) != 0)
+    {
+        close();
+        return false;
+    }
+    size = info.st_size;
+#endif
+
+    return map(write);
+}
+
+bool MappedFile::create(const std::string &path, u64 size)
+{
+    close();
+    this->size = size;
+
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER length;
+    length.QuadPart = size;
+    if (file == INVALID_HANDLE_VALUE || !SetFilePointerEx(file, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+    {
+        close();
+        return false;
+    }
+#else
+    file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file == -1 || ftruncate(file, size) != 0)
+    {
+        close();
+        return false;
+    }
+#endif
+
+    return map(true);
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (data)
+    {
+        UnmapViewOfFile(data);
+    }
+    if (mapping)
+    {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data)
+    {
+        munmap(data, size);
+    }
+    if (file != -1)
+    {
+        ::close(file);
+        file = -1;
+    }
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return data != nullptr;
+}
+
+u8 *MappedFile::getData() const
+{
+    return data;
+}
+
+u64 MappedFile::getSize() const
+{
+    return size;
+}
+
+bool MappedFile::map(bool write)
+{
+    if (size == 0)
+    {
+        close();
+        return false;
+    }
+
+#ifdef _WIN32
+    mapping = CreateFileMappingA(file, nullptr, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+    {
+        data = static_cast<u8 *>(MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    void *address = mmap(nullptr, size, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+    if (address != MAP_FAILED)
+    {
+        data = static_cast<u8 *>(address);
+    }
+#endif
+
+    if (!data)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
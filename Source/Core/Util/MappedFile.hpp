@@ -0,0 +1,54 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <Core/Util/Global.hpp>
+#include <string>
+
+// Memory mapped view of a whole file, either opened as is or created/resized with write access
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    void operator=(const MappedFile &) = delete;
+    bool open(const std::string &path, bool write = false);
+    bool create(const std::string &path, u64 size);
+    void close();
+    bool isOpen() const;
+    u8 *getData() const;
+    u64 getSize() const;
+
+private:
+#ifdef _WIN32
+    void *file;
+    void *mapping;
+#else
+    int file;
+#endif
+    u8 *data;
+    u64 size;
+
+    bool map(bool write);
+};
+
+#endif // MAPPEDFILE_HPP
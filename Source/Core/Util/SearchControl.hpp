@@ -0,0 +1,136 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHCONTROL_HPP
+#define SEARCHCONTROL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Cancel and pause requests for the workers of a search. Workers poll every chunk of frames, the poll is a single
+// atomic load while the search runs and blocks while it is paused so paused workers give their CPU to other jobs.
+class SearchControl
+{
+public:
+    SearchControl() : state(State::Cancelled), pausedTime(0)
+    {
+    }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        state = State::Running;
+        pausedTime = std::chrono::steady_clock::duration(0);
+    }
+
+    void cancel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finishPause();
+            state = State::Cancelled;
+        }
+        condition.notify_all();
+    }
+
+    void pause()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state == State::Running)
+        {
+            pauseStart = std::chrono::steady_clock::now();
+            state = State::Paused;
+        }
+    }
+
+    void resume()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finishPause();
+            if (state == State::Paused)
+            {
+                state = State::Running;
+            }
+        }
+        condition.notify_all();
+    }
+
+    // Returns false once the search is cancelled, waits while it is paused
+    bool poll()
+    {
+        State current = state.load(std::memory_order_acquire);
+        if (current == State::Paused)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return state != State::Paused; });
+            current = state;
+        }
+        return current != State::Cancelled;
+    }
+
+    bool isCancelled() const
+    {
+        return state.load(std::memory_order_acquire) == State::Cancelled;
+    }
+
+    bool isPaused() const
+    {
+        return state.load(std::memory_order_acquire) == State::Paused;
+    }
+
+    // Time spent paused since the search started, including a pause that is still going on
+    std::chrono::steady_clock::duration getPausedTime() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto time = pausedTime;
+        if (state == State::Paused)
+        {
+            time += std::chrono::steady_clock::now() - pauseStart;
+        }
+        return time;
+    }
+
+private:
+    enum class State
+    {
+        Running,
+        Paused,
+        Cancelled
+    };
+
+    std::atomic<State> state;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::chrono::steady_clock::time_point pauseStart;
+    std::chrono::steady_clock::duration pausedTime;
+
+    // Called with the lock held
+    void finishPause()
+    {
+        if (state == State::Paused)
+        {
+            pausedTime += std::chrono::steady_clock::now() - pauseStart;
+        }
+    }
+};
+
+#endif // SEARCHCONTROL_HPP
@@ -0,0 +1,208 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SearchJournal.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+constexpr char magic[8] = { '3', 'D', 'S', 'T', 'F', 'J', 'N', 'L' };
+constexpr u32 version = 1;
+
+struct SearchJournalHeader
+{
+    char magic[8];
+    u32 version;
+    u32 resultSize;
+    u32 tileThreads;
+    u32 tileCount;
+    u64 key;
+};
+
+struct SearchJournalRecord
+{
+    u32 tile;
+    u32 count;
+};
+
+SearchJournal::SearchJournal() : file(nullptr), resultSize(0), tileThreads(0), tileCount(0)
+{
+}
+
+SearchJournal::~SearchJournal()
+{
+    close();
+}
+
+bool SearchJournal::load(const std::string &path, u64 key, u32 resultSize)
+{
+    close();
+
+    std::ifstream read(path, std::ios::binary);
+    if (!read.is_open())
+    {
+        return false;
+    }
+    std::vector<u8> data((std::istreambuf_iterator<char>(read)), std::istreambuf_iterator<char>());
+    read.close();
+
+    SearchJournalHeader header;
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version || header.key != key
+        || header.resultSize != resultSize)
+    {
+        return false;
+    }
+
+    this->resultSize = resultSize;
+    tileThreads = header.tileThreads;
+    tileCount = header.tileCount;
+    finished.assign(tileCount, false);
+    results.clear();
+
+    // Everything after the last complete record is a write the crash interrupted
+    size_t offset = sizeof(header);
+    while (data.size() - offset >= sizeof(SearchJournalRecord))
+    {
+        SearchJournalRecord record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        size_t size = static_cast<size_t>(record.count) * resultSize;
+        if (record.tile >= tileCount || data.size() - offset - sizeof(record) < size)
+        {
+            break;
+        }
+
+        const u8 *begin = data.data() + offset + sizeof(record);
+        results.insert(results.end(), begin, begin + size);
+        finished[record.tile] = true;
+        offset += sizeof(record) + size;
+    }
+
+    std::error_code error;
+    std::filesystem::resize_file(path, offset, error);
+    file = error ? nullptr : std::fopen(path.c_str(), "ab");
+    if (file == nullptr)
+    {
+        finished.clear();
+        results.clear();
+        return false;
+    }
+
+    this->path = path;
+    return true;
+}
+
+bool SearchJournal::create(const std::string &path, u64 key, u32 resultSize, u32 tileThreads, u32 tileCount)
+{
+    close();
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    SearchJournalHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.resultSize = resultSize;
+    header.tileThreads = tileThreads;
+    header.tileCount = tileCount;
+    header.key = key;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1 || std::fflush(file) != 0)
+    {
+        close();
+        return false;
+    }
+
+    this->path = path;
+    this->resultSize = resultSize;
+    this->tileThreads = tileThreads;
+    this->tileCount = tileCount;
+    finished.assign(tileCount, false);
+    results.clear();
+    return true;
+}
+
+void SearchJournal::add(u32 tile, const void *results, u32 count)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    // Flushed per record so everything a crash can lose is the tiles that were still running
+    SearchJournalRecord record = { tile, count };
+    std::fwrite(&record, sizeof(record), 1, file);
+    std::fwrite(results, resultSize, count, file);
+    std::fflush(file);
+}
+
+void SearchJournal::finish()
+{
+    close();
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
+
+void SearchJournal::close()
+{
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+    finished.clear();
+    results.clear();
+}
+
+bool SearchJournal::isOpen() const
+{
+    return file != nullptr;
+}
+
+bool SearchJournal::isFinished(u32 tile) const
+{
+    return tile < finished.size() && finished[tile];
+}
+
+u32 SearchJournal::getTileThreads() const
+{
+    return tileThreads;
+}
+
+u32 SearchJournal::getTileCount() const
+{
+    return tileCount;
+}
+
+std::vector<u8> SearchJournal::takeResults()
+{
+    return std::move(results);
+}
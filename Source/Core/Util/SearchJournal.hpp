@@ -0,0 +1,60 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEARCHJOURNAL_HPP
+#define SEARCHJOURNAL_HPP
+
+#include <Core/Util/Global.hpp>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Append only file recording which tiles of a search finished and the results each of them published, so an
+// interrupted search can resume without searching those tiles again. Records cut short by a crash are dropped.
+class SearchJournal
+{
+public:
+    SearchJournal();
+    ~SearchJournal();
+    SearchJournal(const SearchJournal &) = delete;
+    void operator=(const SearchJournal &) = delete;
+    bool load(const std::string &path, u64 key, u32 resultSize);
+    bool create(const std::string &path, u64 key, u32 resultSize, u32 tileThreads, u32 tileCount);
+    void add(u32 tile, const void *results, u32 count);
+    void finish();
+    void close();
+    bool isOpen() const;
+    bool isFinished(u32 tile) const;
+    u32 getTileThreads() const;
+    u32 getTileCount() const;
+    std::vector<u8> takeResults();
+
+private:
+    std::FILE *file;
+    std::string path;
+    std::mutex mutex;
+    u32 resultSize;
+    u32 tileThreads;
+    u32 tileCount;
+    std::vector<bool> finished;
+    std::vector<u8> results;
+};
+
+#endif // SEARCHJOURNAL_HPP
@@ -0,0 +1,153 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SeedIndex.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+constexpr char magic[8] = { '3', 'D', 'S', 'T', 'F', 'I', 'D', 'X' };
+constexpr u32 version = 1;
+constexpr u64 headerSize = 64;
+constexpr u64 bitsSize = 0x20000000;
+
+struct SeedIndexHeader
+{
+    char magic[8];
+    u32 version;
+    u32 startFrame;
+    u32 endFrame;
+    u32 reserved;
+    u64 key;
+};
+
+SeedIndex::SeedIndex() : bits(nullptr)
+{
+}
+
+std::string SeedIndex::getFileName(u64 key, u32 startFrame, u32 endFrame)
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "%016llx_%u_%u.idx", static_cast<unsigned long long>(key), startFrame, endFrame);
+    return name;
+}
+
+bool SeedIndex::load(const std::string &directory, u64 key, u32 startFrame, u32 endFrame)
+{
+    file.close();
+    bits = nullptr;
+
+    std::error_code error;
+    if (directory.empty() || !std::filesystem::is_directory(directory, error))
+    {
+        return false;
+    }
+
+    // Any index for the same configuration whose frame range contains the searched range can be used
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        unsigned long long fileKey;
+        u32 fileStart, fileEnd;
+        std::string name = entry.path().filename().string();
+        if (std::sscanf(name.c_str(), "%llx_%u_%u.idx", &fileKey, &fileStart, &fileEnd) == 3
+            && name == getFileName(fileKey, fileStart, fileEnd) && fileKey == key && fileStart <= startFrame && fileEnd >= endFrame
+            && open(entry.path().string(), key, fileStart, fileEnd))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SeedIndex::create(const std::string &directory, u64 key, u32 startFrame, u32 endFrame)
+{
+    bits = nullptr;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // Built under a temporary name so an unfinished index is never picked up by load()
+    path = (std::filesystem::path(directory) / getFileName(key, startFrame, endFrame)).string();
+    if (!file.create(path + ".tmp", headerSize + bitsSize))
+    {
+        return false;
+    }
+
+    SeedIndexHeader header = {};
+    header.version = version;
+    header.startFrame = startFrame;
+    header.endFrame = endFrame;
+    header.key = key;
+    std::memcpy(file.getData(), &header, sizeof(header));
+
+    bits = file.getData() + headerSize;
+    return true;
+}
+
+bool SeedIndex::finish()
+{
+    if (!file.isOpen())
+    {
+        return false;
+    }
+
+    std::memcpy(file.getData(), magic, sizeof(magic));
+    file.close();
+    bits = nullptr;
+
+    std::error_code error;
+    std::filesystem::rename(path + ".tmp", path, error);
+    return !error;
+}
+
+void SeedIndex::discard()
+{
+    file.close();
+    bits = nullptr;
+
+    std::error_code error;
+    std::filesystem::remove(path + ".tmp", error);
+}
+
+bool SeedIndex::isOpen() const
+{
+    return bits != nullptr;
+}
+
+bool SeedIndex::open(const std::string &path, u64 key, u32 startFrame, u32 endFrame)
+{
+    if (!file.open(path) || file.getSize() != headerSize + bitsSize)
+    {
+        file.close();
+        return false;
+    }
+
+    SeedIndexHeader header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version || header.key != key
+        || header.startFrame != startFrame || header.endFrame != endFrame)
+    {
+        file.close();
+        return false;
+    }
+
+    bits = file.getData() + headerSize;
+    return true;
+}
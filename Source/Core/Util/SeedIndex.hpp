@@ -0,0 +1,58 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SEEDINDEX_HPP
+#define SEEDINDEX_HPP
+
+#include <Core/Util/MappedFile.hpp>
+#include <string>
+
+// Memory mapped 2^32 bit set marking which initial seeds have at least one hit inside a frame range
+// for a given search configuration. Files are named by configuration key and frame range.
+class SeedIndex
+{
+public:
+    SeedIndex();
+    static std::string getFileName(u64 key, u32 startFrame, u32 endFrame);
+    bool load(const std::string &directory, u64 key, u32 startFrame, u32 endFrame);
+    bool create(const std::string &directory, u64 key, u32 startFrame, u32 endFrame);
+    bool finish();
+    void discard();
+    bool isOpen() const;
+
+    bool test(u32 seed) const
+    {
+        return (bits[seed >> 3] >> (seed & 7)) & 1;
+    }
+
+    // Not atomic, callers must make sure threads never share a byte
+    void set(u32 seed)
+    {
+        bits[seed >> 3] |= 1 << (seed & 7);
+    }
+
+private:
+    MappedFile file;
+    std::string path;
+    u8 *bits;
+
+    bool open(const std::string &path, u64 key, u32 startFrame, u32 endFrame);
+};
+
+#endif // SEEDINDEX_HPP
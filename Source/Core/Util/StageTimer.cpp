@@ -0,0 +1,143 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "StageTimer.hpp"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace
+{
+    struct ThreadCounters
+    {
+        size_t thread;
+        StageCounters counters;
+    };
+
+    constexpr std::array<const char *, static_cast<size_t>(Stage::Count)> stageNames
+        = { "seedHash", "generatorInit", "shuffle", "frameGeneration", "filter", "publish" };
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadCounters>> threads;
+    std::atomic<u32> generation = 1;
+    std::string reportPath = "3DSTimeFinderStages.json";
+
+    const char *getClock()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) || defined(__x86_64__) || defined(__i386__)
+        return "tsc";
+#elif defined(__aarch64__)
+        return "cntvct";
+#else
+        return "ns";
+#endif
+    }
+
+    json getStages(const StageCounters &counters)
+    {
+        u64 total = 0;
+        for (u64 cycles : counters.cycles)
+        {
+            total += cycles;
+        }
+
+        json stages = json::object();
+        for (size_t i = 0; i < stageNames.size(); i++)
+        {
+            json stage;
+            stage["cycles"] = counters.cycles[i];
+            stage["calls"] = counters.calls[i];
+            stage["cyclesPerCall"] = counters.calls[i] == 0 ? 0.0 : static_cast<double>(counters.cycles[i]) / counters.calls[i];
+            stage["share"] = total == 0 ? 0.0 : static_cast<double>(counters.cycles[i]) / total;
+            stages[stageNames[i]] = stage;
+        }
+        return stages;
+    }
+}
+
+thread_local u64 StageTimer::nested = 0;
+
+void StageTimer::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.clear();
+    generation++;
+}
+
+bool StageTimer::writeReport(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    StageCounters total;
+    json report;
+    report["clock"] = getClock();
+    report["threads"] = json::array();
+    for (const auto &thread : threads)
+    {
+        for (size_t i = 0; i < stageNames.size(); i++)
+        {
+            total.cycles[i] += thread->counters.cycles[i];
+            total.calls[i] += thread->counters.calls[i];
+        }
+
+        json entry;
+        entry["thread"] = thread->thread;
+        entry["stages"] = getStages(thread->counters);
+        report["threads"].emplace_back(entry);
+    }
+    report["total"] = getStages(total);
+
+    std::ofstream write(path);
+    write << report.dump(4);
+    return write.good();
+}
+
+const std::string &StageTimer::getReportPath()
+{
+    return reportPath;
+}
+
+void StageTimer::setReportPath(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    reportPath = path;
+}
+
+StageCounters &StageTimer::getCounters()
+{
+    // Each thread keeps its own counters alive so they can be reported after the thread exits
+    thread_local std::shared_ptr<ThreadCounters> local;
+    thread_local u32 localGeneration = 0;
+
+    u32 current = generation;
+    if (localGeneration != current)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        local = std::make_shared<ThreadCounters>();
+        local->thread = threads.size();
+        threads.emplace_back(local);
+        localGeneration = current;
+    }
+    return local->counters;
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef STAGETIMER_HPP
+#define STAGETIMER_HPP
+
+#include <Core/Util/Global.hpp>
+#include <array>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+enum class Stage : u8
+{
+    SeedHash,
+    GeneratorInit,
+    Shuffle,
+    FrameGeneration,
+    Filter,
+    Publish,
+    Count
+};
+
+struct StageCounters
+{
+    std::array<u64, static_cast<size_t>(Stage::Count)> cycles {};
+    std::array<u64, static_cast<size_t>(Stage::Count)> calls {};
+};
+
+// Accumulates cycles and calls per stage for every thread. Time spent in a nested stage is only counted
+// for the innermost stage so the stages add up to the time spent inside them. Only compiled into the
+// searchers when TIMEFINDER_STAGE_TIMERS is defined, see STAGE_TIMER below.
+class StageTimer
+{
+public:
+    explicit StageTimer(Stage stage) : stage(stage), outerNested(nested)
+    {
+        nested = 0;
+        start = now();
+    }
+
+    ~StageTimer()
+    {
+        u64 elapsed = now() - start;
+        StageCounters &counters = getCounters();
+        counters.cycles[static_cast<size_t>(stage)] += elapsed - nested;
+        counters.calls[static_cast<size_t>(stage)]++;
+        nested = outerNested + elapsed;
+    }
+
+    StageTimer(const StageTimer &) = delete;
+    StageTimer &operator=(const StageTimer &) = delete;
+
+    static u64 now()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        u64 value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    // Drops the counters of previous searches, threads register again the next time they time a stage
+    static void reset();
+
+    // Writes every thread's counters and their totals as JSON
+    static bool writeReport(const std::string &path);
+
+    static const std::string &getReportPath();
+    static void setReportPath(const std::string &path);
+
+private:
+    Stage stage;
+    u64 start;
+    u64 outerNested;
+
+    static thread_local u64 nested;
+
+    static StageCounters &getCounters();
+};
+
+#ifdef TIMEFINDER_STAGE_TIMERS
+#define STAGE_TIMER_CONCAT(a, b) a##b
+#define STAGE_TIMER_NAME(line) STAGE_TIMER_CONCAT(stageTimer, line)
+#define STAGE_TIMER(stage) StageTimer STAGE_TIMER_NAME(__LINE__)(stage)
+#define STAGE_TIMER_RESET() StageTimer::reset()
+#define STAGE_TIMER_REPORT() StageTimer::writeReport(StageTimer::getReportPath())
+#else
+#define STAGE_TIMER(stage)
+#define STAGE_TIMER_RESET()
+#define STAGE_TIMER_REPORT()
+#endif
+
+#endif // STAGETIMER_HPP
@@ -0,0 +1,260 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "TimeMask.hpp"
+#include <Core/Util/DateTime.hpp>
+#include <Core/Util/Hash.hpp>
+#include <Core/Util/Utility.hpp>
+#include <algorithm>
+#include <sstream>
+
+constexpr u64 daySeconds = 86400;
+
+namespace
+{
+    // Sorts the runs and joins the ones that overlap or touch
+    std::vector<std::pair<u64, u64>> merge(std::vector<std::pair<u64, u64>> runs)
+    {
+        std::sort(runs.begin(), runs.end());
+
+        std::vector<std::pair<u64, u64>> merged;
+        for (const auto &run : runs)
+        {
+            if (!merged.empty() && run.first <= merged.back().second + 1)
+            {
+                merged.back().second = std::max(merged.back().second, run.second);
+            }
+            else
+            {
+                merged.emplace_back(run);
+            }
+        }
+        return merged;
+    }
+
+    // Reads "H[:MM[:SS]]" as seconds of the day, 24 is the end of the day
+    bool getTime(const std::string &text, u32 &seconds)
+    {
+        std::vector<u32> parts;
+        std::string part;
+        std::stringstream stream(text);
+        while (std::getline(stream, part, ':'))
+        {
+            if (part.empty() || part.size() > 2 || !std::all_of(part.begin(), part.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            {
+                return false;
+            }
+            parts.emplace_back(std::stoul(part));
+        }
+        parts.resize(3, 0);
+
+        seconds = parts[0] * 3600 + parts[1] * 60 + parts[2];
+        return !text.empty() && text.back() != ':' && std::count(text.begin(), text.end(), ':') < 3 && parts[1] < 60 && parts[2] < 60
+            && seconds <= daySeconds;
+    }
+}
+
+TimeMask::TimeMask() : weekdays(0x7f)
+{
+}
+
+void TimeMask::setWeekdays(u8 weekdays)
+{
+    this->weekdays = weekdays & 0x7f;
+}
+
+void TimeMask::setWeekdays(const std::vector<bool> &weekdays)
+{
+    u8 bits = 0;
+    for (size_t i = 0; i < weekdays.size() && i < 7; i++)
+    {
+        bits |= weekdays[i] << i;
+    }
+    setWeekdays(bits);
+}
+
+void TimeMask::addTime(u32 start, u32 end)
+{
+    start = std::min<u32>(start, daySeconds);
+    end = std::min<u32>(end, daySeconds);
+    if (start <= end)
+    {
+        times.emplace_back(start, end);
+    }
+    else
+    {
+        times.emplace_back(start, daySeconds);
+        times.emplace_back(0, end);
+    }
+}
+
+bool TimeMask::addTimes(const std::string &text)
+{
+    std::vector<std::pair<u32, u32>> added;
+
+    std::string item;
+    std::stringstream stream(text);
+    while (std::getline(stream, item, ','))
+    {
+        item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return c == ' ' || c == '\t'; }), item.end());
+        if (item.empty())
+        {
+            continue;
+        }
+
+        size_t dash = item.find('-');
+        u32 start, end;
+        if (dash == std::string::npos || !getTime(item.substr(0, dash), start) || !getTime(item.substr(dash + 1), end) || start == end)
+        {
+            return false;
+        }
+        added.emplace_back(start, end);
+    }
+
+    for (const auto &time : added)
+    {
+        addTime(time.first, time.second);
+    }
+    return true;
+}
+
+void TimeMask::addInterval(const DateTime &start, const DateTime &end)
+{
+    u64 first = start.toMSecsSinceEpoch() / 1000;
+    u64 last = end.toMSecsSinceEpoch() / 1000;
+    if (first <= last)
+    {
+        intervals.emplace_back(first, last);
+    }
+}
+
+bool TimeMask::isEnabled() const
+{
+    return weekdays != 0x7f || !times.empty() || !intervals.empty();
+}
+
+std::vector<std::pair<u64, u64>> TimeMask::getRuns(u64 epochStart, u64 epochEnd, u64 offset) const
+{
+    // Works in whole seconds since 1970, every epoch of the range shares the milliseconds of the first
+    u64 first = Utility::getNormalTime(epochStart, offset) / 1000;
+    u64 last = first + (epochEnd - epochStart) / 1000;
+
+    std::vector<std::pair<u64, u64>> runs;
+    if (weekdays == 0x7f && times.empty())
+    {
+        runs.emplace_back(first, last);
+    }
+    else
+    {
+        std::vector<std::pair<u64, u64>> windows;
+        for (const auto &time : times)
+        {
+            if (time.first < time.second)
+            {
+                windows.emplace_back(time.first, time.second - 1);
+            }
+        }
+        windows = times.empty() ? std::vector<std::pair<u64, u64>> { { 0, daySeconds - 1 } } : merge(windows);
+
+        for (u64 day = first / daySeconds; day <= last / daySeconds; day++)
+        {
+            // Jan 1, 1970 was a Thursday
+            if (((weekdays >> ((day + 4) % 7)) & 1) == 0)
+            {
+                continue;
+            }
+
+            for (const auto &window : windows)
+            {
+                u64 start = std::max(first, day * daySeconds + window.first);
+                u64 end = std::min(last, day * daySeconds + window.second);
+                if (start > end)
+                {
+                    continue;
+                }
+
+                if (!runs.empty() && start == runs.back().second + 1)
+                {
+                    runs.back().second = end;
+                }
+                else
+                {
+                    runs.emplace_back(start, end);
+                }
+            }
+        }
+    }
+
+    if (!intervals.empty())
+    {
+        std::vector<std::pair<u64, u64>> allowed = merge(intervals);
+        std::vector<std::pair<u64, u64>> kept;
+        for (size_t i = 0, j = 0; i < runs.size() && j < allowed.size();)
+        {
+            u64 start = std::max(runs[i].first, allowed[j].first);
+            u64 end = std::min(runs[i].second, allowed[j].second);
+            if (start <= end)
+            {
+                kept.emplace_back(start, end);
+            }
+
+            if (runs[i].second < allowed[j].second)
+            {
+                i++;
+            }
+            else
+            {
+                j++;
+            }
+        }
+        runs = std::move(kept);
+    }
+
+    for (auto &run : runs)
+    {
+        run.first = epochStart + (run.first - first) * 1000;
+        run.second = epochStart + (run.second - first) * 1000;
+    }
+    return runs;
+}
+
+u64 TimeMask::getSeconds(u64 epochStart, u64 epochEnd, u64 offset) const
+{
+    u64 seconds = 0;
+    for (const auto &run : getRuns(epochStart, epochEnd, offset))
+    {
+        seconds += (run.second - run.first) / 1000 + 1;
+    }
+    return seconds;
+}
+
+u64 TimeMask::getKey() const
+{
+    Hash hash;
+    hash.add(weekdays).add(times.size()).add(intervals.size());
+    for (const auto &time : times)
+    {
+        hash.add(time.first).add(time.second);
+    }
+    for (const auto &interval : intervals)
+    {
+        hash.add(interval.first).add(interval.second);
+    }
+    return hash.get();
+}
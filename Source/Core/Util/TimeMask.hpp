@@ -0,0 +1,65 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TIMEMASK_HPP
+#define TIMEMASK_HPP
+
+#include <Core/Util/Global.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+class DateTime;
+
+// Limits a search to the seconds a player can act at. A second is allowed when its weekday is, it falls in one of the
+// times of day and, when intervals were added, in one of the intervals. A default mask allows every second.
+class TimeMask
+{
+public:
+    TimeMask();
+
+    // Bit n allows weekday n, Sunday is 0
+    void setWeekdays(u8 weekdays);
+    void setWeekdays(const std::vector<bool> &weekdays);
+
+    // Allows the seconds of each day from start up to but not including end, a start after the end wraps past midnight
+    void addTime(u32 start, u32 end);
+
+    // Adds times of day written like "18:00-23:00, 7-9", returns false without adding any if one is invalid
+    bool addTimes(const std::string &text);
+
+    // Allows every second from start to end
+    void addInterval(const DateTime &start, const DateTime &end);
+
+    // False when every second is allowed
+    bool isEnabled() const;
+
+    // The allowed seconds from epochStart to epochEnd as runs of the epochs of their first and last second
+    std::vector<std::pair<u64, u64>> getRuns(u64 epochStart, u64 epochEnd, u64 offset) const;
+
+    u64 getSeconds(u64 epochStart, u64 epochEnd, u64 offset) const;
+    u64 getKey() const;
+
+private:
+    std::vector<std::pair<u32, u32>> times;
+    std::vector<std::pair<u64, u64>> intervals;
+    u8 weekdays;
+};
+
+#endif // TIMEMASK_HPP
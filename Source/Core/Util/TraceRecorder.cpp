@@ -0,0 +1,147 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "TraceRecorder.hpp"
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    // Keeps a forgotten trace on a long search from eating all memory, later events are counted as dropped
+    constexpr size_t maximumEvents = 1 << 20;
+
+    void addEvents(json &events, const std::vector<TraceEvent> &buffer, u32 tid)
+    {
+        for (const auto &event : buffer)
+        {
+            json entry;
+            entry["name"] = event.name;
+            entry["cat"] = "search";
+            entry["ph"] = std::string(1, event.phase);
+            entry["ts"] = event.start / 1000.0;
+            entry["pid"] = 1;
+            entry["tid"] = tid;
+            if (event.phase == 'X')
+            {
+                entry["dur"] = (event.end - event.start) / 1000.0;
+            }
+            else
+            {
+                entry["s"] = "t";
+            }
+            if (event.argName != nullptr)
+            {
+                entry["args"][event.argName] = event.arg;
+            }
+            events.emplace_back(entry);
+        }
+    }
+
+    json getThreadName(u32 tid, const std::string &name)
+    {
+        json entry;
+        entry["name"] = "thread_name";
+        entry["ph"] = "M";
+        entry["pid"] = 1;
+        entry["tid"] = tid;
+        entry["args"]["name"] = name;
+        return entry;
+    }
+}
+
+TraceRecorder::TraceRecorder() : origin(std::chrono::steady_clock::now()), enabled(false), dropped(0)
+{
+}
+
+void TraceRecorder::start(u32 workers)
+{
+    this->workers.assign(workers, {});
+    {
+        std::lock_guard<std::mutex> lock(pollMutex);
+        poll.clear();
+    }
+    dropped = 0;
+    enabled = true;
+}
+
+void TraceRecorder::stop()
+{
+    enabled = false;
+}
+
+bool TraceRecorder::write(const std::string &path)
+{
+    stop();
+
+    json events = json::array();
+    for (u32 i = 0; i < workers.size(); i++)
+    {
+        events.emplace_back(getThreadName(i, "Worker " + std::to_string(i)));
+        addEvents(events, workers[i], i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pollMutex);
+        u32 tid = static_cast<u32>(workers.size());
+        events.emplace_back(getThreadName(tid, "Results"));
+        addEvents(events, poll, tid);
+    }
+
+    json trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    trace["otherData"]["droppedEvents"] = dropped.load();
+
+    std::ofstream file(path);
+    file << trace.dump();
+    return file.good();
+}
+
+void TraceRecorder::completePoll(const char *name, u64 start, u64 end, const char *argName, u64 arg)
+{
+    if (isEnabled())
+    {
+        std::lock_guard<std::mutex> lock(pollMutex);
+        record(poll, { name, argName, arg, start, end, 'X' });
+    }
+}
+
+void TraceRecorder::instantPoll(const char *name, const char *argName, u64 arg)
+{
+    if (isEnabled())
+    {
+        u64 time = now();
+        std::lock_guard<std::mutex> lock(pollMutex);
+        record(poll, { name, argName, arg, time, time, 'i' });
+    }
+}
+
+void TraceRecorder::record(std::vector<TraceEvent> &events, const TraceEvent &event)
+{
+    if (events.size() < maximumEvents)
+    {
+        events.emplace_back(event);
+    }
+    else
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TRACERECORDER_HPP
+#define TRACERECORDER_HPP
+
+#include <Core/Util/Global.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct TraceEvent
+{
+    const char *name;
+    const char *argName;
+    u64 arg;
+    u64 start;
+    u64 end;
+    char phase;
+};
+
+// Records per thread timeline events of a search and writes them as Chrome trace event JSON for
+// chrome://tracing or Perfetto. Worker buffers are only written by their own thread, the extra
+// poll buffer is shared by whichever threads collect results.
+class TraceRecorder
+{
+public:
+    TraceRecorder();
+    void start(u32 workers);
+    void stop();
+    bool write(const std::string &path);
+
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Nanoseconds since the recorder was created
+    u64 now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void complete(u32 worker, const char *name, u64 start, u64 end, const char *argName = nullptr, u64 arg = 0)
+    {
+        if (isEnabled())
+        {
+            record(workers[worker], { name, argName, arg, start, end, 'X' });
+        }
+    }
+
+    void instant(u32 worker, const char *name, const char *argName = nullptr, u64 arg = 0)
+    {
+        if (isEnabled())
+        {
+            u64 time = now();
+            record(workers[worker], { name, argName, arg, time, time, 'i' });
+        }
+    }
+
+    void completePoll(const char *name, u64 start, u64 end, const char *argName = nullptr, u64 arg = 0);
+    void instantPoll(const char *name, const char *argName = nullptr, u64 arg = 0);
+
+private:
+    std::vector<std::vector<TraceEvent>> workers;
+    std::vector<TraceEvent> poll;
+    std::mutex pollMutex;
+    std::chrono::steady_clock::time_point origin;
+    std::atomic<bool> enabled;
+    std::atomic<u64> dropped;
+
+    void record(std::vector<TraceEvent> &events, const TraceEvent &event);
+};
+
+#endif // TRACERECORDER_HPP
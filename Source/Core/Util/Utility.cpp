@@ -20,6 +20,8 @@
 #include "Utility.hpp"
 #include <Core/RNG/SHA256.hpp>
 #include <Core/Util/DateTime.hpp>
+#include <algorithm>
+#include <sstream>
 
 std::vector<std::string> natures
     = { "Hardy", "Lonely", "Brave",  "Adamant", "Naughty", "Bold",    "Docile", "Relaxed", "Impish", "Lax",   "Timid",   "Hasty", "Serious",
@@ -45,6 +47,50 @@ u32 Utility::calcInitialSeed(u32 tick, u64 epoch)
     return SHA256::hash(tick, static_cast<u32>(epoch & 0xffffffff), static_cast<u32>(epoch >> 32));
 }
 
+void Utility::calcInitialSeeds(u32 tick, const u64 *epochs, u32 count, u32 *seeds)
+{
+    SHA256::hash(tick, epochs, count, seeds);
+}
+
+std::vector<int> Utility::getOffsetDeltas(const std::string &text)
+{
+    constexpr int maximumDelta = 1000;
+
+    std::vector<int> deltas;
+
+    std::string item;
+    std::stringstream stream(text);
+    while (stream >> item)
+    {
+        for (size_t start = 0, end; start < item.size(); start = end + 1)
+        {
+            end = std::min(item.find(',', start), item.size());
+            std::string token = item.substr(start, end - start);
+
+            int low, high;
+            char separator;
+            std::stringstream range(token);
+            if (!(range >> low))
+            {
+                continue;
+            }
+            if (!(range >> separator >> high) || separator != ':')
+            {
+                high = low;
+            }
+
+            low = std::max(low, -maximumDelta);
+            high = std::min(high, maximumDelta);
+            for (int delta = low; delta <= high; delta++)
+            {
+                deltas.emplace_back(delta);
+            }
+        }
+    }
+
+    return deltas;
+}
+
 const std::string &Utility::getNature(u8 nature)
 {
     return natures[nature];
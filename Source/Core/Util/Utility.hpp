@@ -31,6 +31,9 @@ namespace Utility
     u64 getCitraTime(const DateTime &dt, u64 offset = 0);
     u64 getNormalTime(u64 time, u64 offset = 0);
     u32 calcInitialSeed(u32 tick, u64 epoch);
+    void calcInitialSeeds(u32 tick, const u64 *epochs, u32 count, u32 *seeds);
+    // Parses comma or space separated millisecond deltas where a:b is every delta between a and b, invalid entries are skipped
+    std::vector<int> getOffsetDeltas(const std::string &text);
     const std::string &getNature(u8 nature);
     const std::string &getHiddenPower(u8 hiddenPower);
     const std::vector<std::string> &getNatures();
@@ -0,0 +1,102 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "HitCalendar.hpp"
+#include <Core/Util/DateTime.hpp>
+#include <QPainter>
+
+// Julian day of Jan 1, 1970, the histogram counts its days from there
+constexpr qint64 unixJulianDay = 2440588;
+
+HitCalendar::HitCalendar(QWidget *parent) : QCalendarWidget(parent), maximum(0)
+{
+    setGridVisible(true);
+    connect(this, &QCalendarWidget::selectionChanged, this, &HitCalendar::updateToolTip);
+}
+
+void HitCalendar::setHistogram(const SearchHistogram &histogram)
+{
+    days = histogram.getDays();
+    hours = histogram.getHours();
+
+    maximum = 0;
+    for (const auto &[day, bucket] : days)
+    {
+        maximum = std::max(maximum, bucket.hits);
+    }
+
+    // Open at the first day with hits
+    if (!days.empty())
+    {
+        setSelectedDate(QDate::fromJulianDay(unixJulianDay + static_cast<qint64>(days.begin()->first)));
+    }
+    updateToolTip();
+    updateCells();
+}
+
+void HitCalendar::clearHistogram()
+{
+    days.clear();
+    hours.clear();
+    maximum = 0;
+    updateToolTip();
+    updateCells();
+}
+
+void HitCalendar::paintCell(QPainter *painter, const QRect &rect, QDate date) const
+{
+    QCalendarWidget::paintCell(painter, rect, date);
+
+    auto it = days.find(static_cast<u64>(date.toJulianDay() - unixJulianDay));
+    if (it == days.end() || maximum == 0)
+    {
+        return;
+    }
+
+    // Days with any hit stay visible next to the busiest day
+    int alpha = 40 + static_cast<int>(160 * it->second.hits / maximum);
+
+    painter->save();
+    painter->fillRect(rect.adjusted(1, 1, -1, -1), QColor(220, 60, 30, alpha));
+
+    QFont font = painter->font();
+    font.setPointSizeF(font.pointSizeF() * 0.7);
+    painter->setFont(font);
+    painter->drawText(rect.adjusted(2, 1, -2, -1), Qt::AlignRight | Qt::AlignBottom, QString::number(it->second.hits));
+    painter->restore();
+}
+
+void HitCalendar::updateToolTip()
+{
+    u64 day = static_cast<u64>(selectedDate().toJulianDay() - unixJulianDay);
+
+    QStringList lines;
+    for (auto it = hours.lower_bound(day * 24); it != hours.end() && it->first < (day + 1) * 24; ++it)
+    {
+        const HistogramBucket &bucket = it->second;
+        lines.append(tr("%1:00  %2 hits, best frame %3 at %4 (%5 ms, seed %6)")
+                         .arg(it->first % 24, 2, 10, QChar('0'))
+                         .arg(bucket.hits)
+                         .arg(bucket.bestFrame)
+                         .arg(QString::fromStdString(Time(bucket.bestTime % 86400).toString()))
+                         .arg(bucket.bestDelta)
+                         .arg(bucket.bestSeed, 8, 16, QChar('0')));
+    }
+    setToolTip(lines.isEmpty() ? tr("No hits") : lines.join('\n'));
+}
@@ -0,0 +1,47 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HITCALENDAR_HPP
+#define HITCALENDAR_HPP
+
+#include <Core/Parents/SearchHistogram.hpp>
+#include <QCalendarWidget>
+
+// Calendar heatmap of a histogram, each day is shaded by its hits and the tooltip lists the hours of the selected day
+class HitCalendar : public QCalendarWidget
+{
+    Q_OBJECT
+public:
+    explicit HitCalendar(QWidget *parent = nullptr);
+    void setHistogram(const SearchHistogram &histogram);
+    void clearHistogram();
+
+protected:
+    void paintCell(QPainter *painter, const QRect &rect, QDate date) const override;
+
+private:
+    std::map<u64, HistogramBucket> days;
+    std::map<u64, HistogramBucket> hours;
+    u64 maximum;
+
+private slots:
+    void updateToolTip();
+};
+
+#endif // HITCALENDAR_HPP
@@ -0,0 +1,68 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ProgressBar.hpp"
+#include <Core/Parents/SearchStats.hpp>
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    QString getRate(double rate)
+    {
+        constexpr std::array<const char *, 5> suffixes = { "", "k", "M", "G", "T" };
+
+        size_t suffix = 0;
+        while (rate >= 1000 && suffix < suffixes.size() - 1)
+        {
+            rate /= 1000;
+            suffix++;
+        }
+        return QString::number(rate, 'f', suffix == 0 ? 0 : 1) + suffixes[suffix];
+    }
+
+    QString getDuration(double seconds)
+    {
+        u64 total = static_cast<u64>(seconds);
+        u64 days = total / 86400;
+        QString time = QString("%1:%2:%3")
+                           .arg((total / 3600) % 24, 2, 10, QChar('0'))
+                           .arg((total / 60) % 60, 2, 10, QChar('0'))
+                           .arg(total % 60, 2, 10, QChar('0'));
+        return days != 0 ? QString("%1d %2").arg(days).arg(time) : time;
+    }
+}
+
+ProgressBar::ProgressBar(QWidget *parent) : QProgressBar(parent)
+{
+}
+
+void ProgressBar::setStats(const SearchStats &stats)
+{
+    // Searches can span more seconds than an int holds so the bar works in hundredths of a percent
+    constexpr int steps = 10000;
+
+    setRange(0, steps);
+    setValue(stats.maxProgress == 0 ? 0 : static_cast<int>(std::min(stats.progress, stats.maxProgress) * steps / stats.maxProgress));
+
+    QString eta = stats.eta < 0 ? tr("unknown") : getDuration(stats.eta);
+    setFormat(tr("%p% | %1 seeds/s | %2 frames/s | %3 hits | %4 elapsed | ETA %5")
+                  .arg(getRate(stats.seedsPerSecond), getRate(stats.framesPerSecond), QString::number(stats.hits),
+                       getDuration(stats.elapsed), eta));
+}
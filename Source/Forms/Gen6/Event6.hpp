@@ -20,10 +20,13 @@
 #ifndef EVENT6_HPP
 #define EVENT6_HPP
 
+#include <Core/Parents/ResultCache.hpp>
 #include <QWidget>
 
 class EventModel;
+class EventResult;
 class Profile6;
+class SearchCoverage;
 
 namespace Ui
 {
@@ -45,6 +48,8 @@ private:
     Ui::Event6 *ui;
     EventModel *model;
     std::vector<Profile6> profiles;
+    std::shared_ptr<ResultCache<EventResult>> cache;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModels();
 
@@ -21,17 +21,24 @@
 #include "ui_Stationary6.h"
 #include <Core/Gen6/StationarySearcher6.hpp>
 #include <Core/Parents/ProfileLoader.hpp>
+#include <Core/Parents/SearchHistogram.hpp>
 #include <Core/Parents/StationaryResult.hpp>
+#include <Core/Util/TimeMask.hpp>
 #include <Core/Util/Utility.hpp>
 #include <Forms/Controls/Controls.hpp>
 #include <Forms/Gen6/ProfileManager6.hpp>
 #include <Forms/Models/StationaryModel.hpp>
+#include <QDateTime>
 #include <QMessageBox>
 #include <QSettings>
 #include <QThread>
 #include <QTimer>
 
-Stationary6::Stationary6(QWidget *parent) : QWidget(parent), ui(new Ui::Stationary6)
+Stationary6::Stationary6(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::Stationary6),
+    cache(std::make_shared<ResultCache<StationaryResult>>()),
+    coverage(std::make_shared<SearchCoverage>())
 {
     ui->setupUi(this);
     setAttribute(Qt::WA_QuitOnClose, false);
@@ -91,6 +98,9 @@ void Stationary6::setupModel()
 
     ui->textBoxStartFrame->setValues(InputType::Frame32Bit);
     ui->textBoxEndFrame->setValues(InputType::Frame32Bit);
+    ui->textBoxResultLimit->setValues(InputType::Delay);
+    ui->checkListWeekdays->setup({ "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" });
+    ui->hitCalendar->hide();
 
     ui->dateTimeEditStartDate->setCalendarPopup(true);
     ui->dateTimeEditEndDate->setCalendarPopup(true);
@@ -138,9 +148,19 @@ void Stationary6::search()
         return;
     }
 
-    model->clearModel();
+    TimeMask mask;
+    mask.setWeekdays(ui->checkListWeekdays->getChecked());
+    if (!mask.addTimes(ui->lineEditTimeMask->text().toStdString()))
+    {
+        QMessageBox error;
+        error.setText("Set allowed times like 18:00-23:00, 7-9");
+        error.exec();
+        return;
+    }
+
     ui->pushButtonSearch->setEnabled(false);
     ui->pushButtonCancel->setEnabled(true);
+    ui->pushButtonPause->setEnabled(true);
 
     std::array<u8, 6> min = ui->filter->getMinIVs();
     std::array<u8, 6> max = ui->filter->getMaxIVs();
@@ -153,20 +173,58 @@ void Stationary6::search()
         ui->checkBoxAbilityLock->isChecked() ? static_cast<u8>(ui->comboBoxAbilityLock->currentIndex()) : 255,
         static_cast<u8>(ui->comboBoxSynchNature->currentIndex()), ui->comboBoxGenderRatio->getCurrentByte(),
         ui->checkBoxAlwaysSynch->isChecked(), ui->checkBoxShinyLock->isChecked(), profiles[ui->comboBoxProfiles->currentIndex()], filter);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    auto cancel = connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    auto pause = connect(ui->pushButtonPause, &QPushButton::toggled, this, [=](bool checked) {
+        if (checked)
+        {
+            searcher->pauseSearch();
+        }
+        else
+        {
+            searcher->resumeSearch();
+        }
+        ui->pushButtonPause->setText(checked ? "Resume" : "Pause");
+    });
 
-    ui->progressBar->setRange(0, searcher->getMaxProgress());
+    ui->progressBar->setStats(searcher->getStats());
 
     QSettings settings;
     int threads = settings.value("settings/threads", QThread::idealThreadCount()).toInt();
+    searcher->loadSeedIndex(settings.value("settings/indexes").toString().toStdString());
+    searcher->setResultCache(cache);
+    searcher->setSearchCoverage(coverage);
+    searcher->setJournalPath(QString("%1/stationary6.journal").arg(settings.value("settings/journals").toString()).toStdString());
+    searcher->setResultLimit(ui->textBoxResultLimit->getUInt());
+    searcher->setTimeMask(mask);
+    if (ui->checkBoxNearest->isChecked())
+    {
+        QDateTime now = QDateTime::currentDateTime();
+        searcher->setAnchor(DateTime(now.date().toJulianDay(), now.time().msecsSinceStartOfDay() / 1000), 0);
+    }
+
+    // Hit counts replace the results table with a calendar of when the hits are
+    std::shared_ptr<SearchHistogram> histogram;
+    if (ui->checkBoxAggregate->isChecked())
+    {
+        histogram = std::make_shared<SearchHistogram>();
+        searcher->setHistogram(histogram);
+        ui->hitCalendar->clearHistogram();
+    }
+    ui->tableView->setVisible(!histogram);
+    ui->hitCalendar->setVisible(histogram != nullptr);
+
+    // Widening the range of the last search only adds the results of the new part
+    if (!searcher->isIncremental())
+    {
+        model->clearModel();
+    }
 
     auto *thread = QThread::create([=] { searcher->startSearch(threads); });
     connect(thread, &QThread::finished, thread, &QThread::deleteLater);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, [searcher] { searcher->cancelSearch(); });
 
     auto *timer = new QTimer();
     connect(timer, &QTimer::timeout, [=] {
-        ui->progressBar->setValue(searcher->getProgress());
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
     });
     connect(thread, &QThread::finished, timer, &QTimer::stop);
@@ -174,8 +232,17 @@ void Stationary6::search()
     connect(timer, &QTimer::destroyed, [=] {
         ui->pushButtonSearch->setEnabled(true);
         ui->pushButtonCancel->setEnabled(false);
-        ui->progressBar->setValue(searcher->getProgress());
+        QObject::disconnect(cancel);
+        QObject::disconnect(pause);
+        ui->pushButtonPause->setChecked(false);
+        ui->pushButtonPause->setText("Pause");
+        ui->pushButtonPause->setEnabled(false);
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
+        if (histogram)
+        {
+            ui->hitCalendar->setHistogram(*histogram);
+        }
         delete searcher;
     });
 
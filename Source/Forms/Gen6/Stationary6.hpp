@@ -20,10 +20,13 @@
 #ifndef STATIONARY6_HPP
 #define STATIONARY6_HPP
 
+#include <Core/Parents/ResultCache.hpp>
 #include <QWidget>
 
 class Profile6;
+class SearchCoverage;
 class StationaryModel;
+class StationaryResult;
 
 namespace Ui
 {
@@ -45,6 +48,8 @@ private:
     Ui::Stationary6 *ui;
     StationaryModel *model;
     std::vector<Profile6> profiles;
+    std::shared_ptr<ResultCache<StationaryResult>> cache;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModel();
 
@@ -22,18 +22,23 @@
 #include <Core/Gen7/EventSearcher7.hpp>
 #include <Core/Parents/EventResult.hpp>
 #include <Core/Parents/ProfileLoader.hpp>
+#include <Core/Parents/SearchHistogram.hpp>
+#include <Core/Parents/Wondercard.hpp>
 #include <Core/Util/PIDType.hpp>
+#include <Core/Util/TimeMask.hpp>
 #include <Core/Util/Utility.hpp>
 #include <Forms/Controls/Controls.hpp>
 #include <Forms/Gen7/ProfileManager7.hpp>
 #include <Forms/Models/EventModel.hpp>
+#include <QDateTime>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QSettings>
 #include <QThread>
 #include <QTimer>
 
-Event7::Event7(QWidget *parent) : QWidget(parent), ui(new Ui::Event7)
+Event7::Event7(QWidget *parent) :
+    QWidget(parent), ui(new Ui::Event7), cache(std::make_shared<ResultCache<EventResult>>()), coverage(std::make_shared<SearchCoverage>())
 {
     ui->setupUi(this);
     setAttribute(Qt::WA_QuitOnClose, false);
@@ -96,6 +101,9 @@ void Event7::setupModel()
 
     ui->textBoxStartFrame->setValues(InputType::Frame32Bit);
     ui->textBoxEndFrame->setValues(InputType::Frame32Bit);
+    ui->textBoxResultLimit->setValues(InputType::Delay);
+    ui->checkListWeekdays->setup({ "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" });
+    ui->hitCalendar->hide();
     ui->textBoxTID->setValues(InputType::ID);
     ui->textBoxSID->setValues(InputType::ID);
     ui->textBoxPID->setValues(InputType::Seed32Bit);
@@ -144,9 +152,19 @@ void Event7::search()
         return;
     }
 
-    model->clearModel();
+    TimeMask mask;
+    mask.setWeekdays(ui->checkListWeekdays->getChecked());
+    if (!mask.addTimes(ui->lineEditTimeMask->text().toStdString()))
+    {
+        QMessageBox error;
+        error.setText("Set allowed times like 18:00-23:00, 7-9");
+        error.exec();
+        return;
+    }
+
     ui->pushButtonSearch->setEnabled(false);
     ui->pushButtonCancel->setEnabled(true);
+    ui->pushButtonPause->setEnabled(true);
 
     std::array<u8, 6> min = ui->filter->getMinIVs();
     std::array<u8, 6> max = ui->filter->getMaxIVs();
@@ -174,20 +192,59 @@ void Event7::search()
                      ui->checkBoxYourID->isChecked());
     searcher->setHidden(ui->textBoxPID->getUInt(), ui->textBoxEC->getUInt());
     searcher->setIVTemplate(ivTemplate);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    searcher->setOffsetDeltas(Utility::getOffsetDeltas(ui->lineEditOffsetDeltas->text().toStdString()));
+    auto cancel = connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    auto pause = connect(ui->pushButtonPause, &QPushButton::toggled, this, [=](bool checked) {
+        if (checked)
+        {
+            searcher->pauseSearch();
+        }
+        else
+        {
+            searcher->resumeSearch();
+        }
+        ui->pushButtonPause->setText(checked ? "Resume" : "Pause");
+    });
 
-    ui->progressBar->setRange(0, searcher->getMaxProgress());
+    ui->progressBar->setStats(searcher->getStats());
 
     QSettings settings;
     int threads = settings.value("settings/threads", QThread::idealThreadCount()).toInt();
+    searcher->loadSeedIndex(settings.value("settings/indexes").toString().toStdString());
+    searcher->setResultCache(cache);
+    searcher->setSearchCoverage(coverage);
+    searcher->setJournalPath(QString("%1/event7.journal").arg(settings.value("settings/journals").toString()).toStdString());
+    searcher->setResultLimit(ui->textBoxResultLimit->getUInt());
+    searcher->setTimeMask(mask);
+    if (ui->checkBoxNearest->isChecked())
+    {
+        QDateTime now = QDateTime::currentDateTime();
+        searcher->setAnchor(DateTime(now.date().toJulianDay(), now.time().msecsSinceStartOfDay() / 1000), 0);
+    }
+
+    // Hit counts replace the results table with a calendar of when the hits are
+    std::shared_ptr<SearchHistogram> histogram;
+    if (ui->checkBoxAggregate->isChecked())
+    {
+        histogram = std::make_shared<SearchHistogram>();
+        searcher->setHistogram(histogram);
+        ui->hitCalendar->clearHistogram();
+    }
+    ui->tableView->setVisible(!histogram);
+    ui->hitCalendar->setVisible(histogram != nullptr);
+
+    // Widening the range of the last search only adds the results of the new part
+    if (!searcher->isIncremental())
+    {
+        model->clearModel();
+    }
 
     auto *thread = QThread::create([=] { searcher->startSearch(threads); });
     connect(thread, &QThread::finished, thread, &QThread::deleteLater);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, [searcher] { searcher->cancelSearch(); });
 
     auto *timer = new QTimer();
     connect(timer, &QTimer::timeout, [=] {
-        ui->progressBar->setValue(searcher->getProgress());
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
     });
     connect(thread, &QThread::finished, timer, &QTimer::stop);
@@ -195,8 +252,17 @@ void Event7::search()
     connect(timer, &QTimer::destroyed, [=] {
         ui->pushButtonSearch->setEnabled(true);
         ui->pushButtonCancel->setEnabled(false);
-        ui->progressBar->setValue(searcher->getProgress());
+        QObject::disconnect(cancel);
+        QObject::disconnect(pause);
+        ui->pushButtonPause->setChecked(false);
+        ui->pushButtonPause->setText("Pause");
+        ui->pushButtonPause->setEnabled(false);
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
+        if (histogram)
+        {
+            ui->hitCalendar->setHistogram(*histogram);
+        }
         delete searcher;
     });
 
@@ -257,109 +323,51 @@ void Event7::importEvent()
     QString fileName = QFileDialog::getOpenFileName(this, "Select a wondercard file", QDir::currentPath(), "Wondercard (*.wc7 *.wc7full)");
     if (!fileName.isEmpty())
     {
-        QFile file(fileName);
-        if (file.open(QIODevice::ReadOnly))
-        {
-            QByteArray fileData = file.readAll();
-            file.close();
-            if (fileData.size() != 784 && fileData.size() != 264)
-            {
-                QMessageBox error;
-                error.setText("Invalid format for wondercard");
-                error.exec();
-                return;
-            }
-
-            if (fileData.size() == 784)
-            {
-                fileData = fileData.mid(520);
-            }
-
-            auto data = fileData.data();
-            if (data[0x51] != 0)
-            {
-                QMessageBox error;
-                error.setText("Invalid wondercard type");
-                error.exec();
-                return;
-            }
-
-            ui->checkBoxAbilityLock->setChecked(data[0xA2] < 3);
-            checkBoxAbilityLock(ui->checkBoxAbilityLock->isChecked());
-            ui->comboBoxAbilityLocked->setCurrentIndex(ui->checkBoxAbilityLock->isChecked() ? data[0xA2] + 1 : data[0xA2] - 3);
-
-            ui->checkBoxNatureLocked->setChecked(static_cast<u8>(data[0xA0]) != 0xFF);
-            ui->comboBoxNatureLocked->setCurrentIndex(ui->checkBoxNatureLocked->isChecked() ? data[0xA0] : 0);
-
-            ui->checkBoxGenderLocked->setChecked(data[0xA1] != 3);
-            ui->comboBoxGenderLocked->setCurrentIndex(ui->checkBoxGenderLocked->isChecked() ? (data[0xA1] + 1) % 3 : 0);
-
-            QVector<u8> ivs;
-            for (u8 order : { 0, 1, 2, 4, 5, 3 })
-            {
-                u8 iv = data[0xAF + order];
-                ivs.append(iv);
-            }
-
-            u8 ivFlag = 0;
-            for (u8 iv : ivs)
-            {
-                u8 value = iv - 0xFC;
-                if (value < 3)
-                {
-                    ivFlag = iv;
-                    break;
-                }
-            }
-
-            ui->spinBoxRandomIVs->setValue(ivFlag == 0 ? 0 : ivFlag - 0xFB);
-
-            ui->checkBoxHP->setChecked(ivFlag == 0 && ivs[0] <= 31);
-            ui->spinBoxHP->setValue(ui->checkBoxHP->isChecked() ? ivs[0] : 0);
-
-            ui->checkBoxAtk->setChecked(ivFlag == 0 && ivs[1] <= 31);
-            ui->spinBoxAtk->setValue(ui->checkBoxAtk->isChecked() ? ivs[1] : 0);
-
-            ui->checkBoxDef->setChecked(ivFlag == 0 && ivs[2] <= 31);
-            ui->spinBoxDef->setValue(ui->checkBoxDef->isChecked() ? ivs[2] : 0);
-
-            ui->checkBoxSpA->setChecked(ivFlag == 0 && ivs[3] <= 31);
-            ui->spinBoxSpA->setValue(ui->checkBoxSpA->isChecked() ? ivs[3] : 0);
-
-            ui->checkBoxSpD->setChecked(ivFlag == 0 && ivs[4] <= 31);
-            ui->spinBoxSpD->setValue(ui->checkBoxSpD->isChecked() ? ivs[4] : 0);
-
-            ui->checkBoxSpe->setChecked(ivFlag == 0 && ivs[5] <= 31);
-            ui->spinBoxSpe->setValue(ui->checkBoxSpe->isChecked() ? ivs[5] : 0);
-
-            ui->checkBoxOtherInfo->setChecked(true);
-            u16 tid = (static_cast<u16>(data[0x69]) << 8) | static_cast<u8>(data[0x68]);
-            ui->textBoxTID->setText(QString::number(tid));
-            u16 sid = (static_cast<u16>(data[0x6B]) << 8) | static_cast<u8>(data[0x6A]);
-            ui->textBoxSID->setText(QString::number(sid));
-
-            u8 typeOrder[4] = { 3, 0, 2, 1 };
-            ui->comboBoxPIDType->setCurrentIndex(typeOrder[data[0xA3]]);
-            if (ui->comboBoxPIDType->currentIndex() == 3)
-            {
-                u32 pid = (data[0xD7] << 24) | (data[0xD6] << 16) | (data[0xD5] << 8) | data[0xD4];
-                ui->textBoxPID->setText(QString::number(pid, 16));
-            }
-
-            u32 ec = (data[0x73] << 24) | (data[0x72] << 16) | (data[0x71] << 8) | data[0x70];
-            ui->textBoxEC->setText(QString::number(ec, 16));
-            ui->labelEC->setVisible(ec > 0);
-            ui->textBoxEC->setVisible(ec > 0);
-
-            ui->checkBoxYourID->setChecked(data[0xB5] == 3);
-            ui->checkBoxEgg->setChecked(data[0xD1] == 1);
-        }
-        else
+        Wondercard card(fileName.toStdString());
+        if (!card.isValid())
         {
             QMessageBox error;
-            error.setText("There was a problem opening the wondercard");
+            error.setText(QString::fromStdString(card.getError()));
             error.exec();
             return;
         }
+
+        ui->checkBoxAbilityLock->setChecked(card.getAbilityLocked());
+        checkBoxAbilityLock(ui->checkBoxAbilityLock->isChecked());
+        ui->comboBoxAbilityLocked->setCurrentIndex(card.getAbility());
+
+        ui->checkBoxNatureLocked->setChecked(card.getNatureLocked());
+        ui->comboBoxNatureLocked->setCurrentIndex(card.getNature());
+
+        ui->checkBoxGenderLocked->setChecked(card.getGenderLocked());
+        ui->comboBoxGenderLocked->setCurrentIndex(card.getGender());
+
+        ui->spinBoxRandomIVs->setValue(card.getIVCount());
+
+        std::array<u8, 6> ivs = card.getIVTemplate();
+        QCheckBox *checkBoxes[6] = { ui->checkBoxHP, ui->checkBoxAtk, ui->checkBoxDef, ui->checkBoxSpA, ui->checkBoxSpD, ui->checkBoxSpe };
+        QSpinBox *spinBoxes[6] = { ui->spinBoxHP, ui->spinBoxAtk, ui->spinBoxDef, ui->spinBoxSpA, ui->spinBoxSpD, ui->spinBoxSpe };
+        for (int i = 0; i < 6; i++)
+        {
+            checkBoxes[i]->setChecked(ivs[i] != 255);
+            spinBoxes[i]->setValue(ivs[i] != 255 ? ivs[i] : 0);
+        }
+
+        ui->checkBoxOtherInfo->setChecked(true);
+        ui->textBoxTID->setText(QString::number(card.getTID()));
+        ui->textBoxSID->setText(QString::number(card.getSID()));
+
+        ui->comboBoxPIDType->setCurrentIndex(card.getPIDType());
+        if (card.getPIDType() == PIDType::Specified)
+        {
+            ui->textBoxPID->setText(QString::number(card.getPID(), 16));
+        }
+
+        ui->textBoxEC->setText(QString::number(card.getEC(), 16));
+        ui->labelEC->setVisible(card.getEC() > 0);
+        ui->textBoxEC->setVisible(card.getEC() > 0);
+
+        ui->checkBoxYourID->setChecked(card.getOwnID());
+        ui->checkBoxEgg->setChecked(card.getEgg());
     }
 }
@@ -20,10 +20,13 @@
 #ifndef EVENT7_HPP
 #define EVENT7_HPP
 
+#include <Core/Parents/ResultCache.hpp>
 #include <QWidget>
 
 class EventModel;
+class EventResult;
 class Profile7;
+class SearchCoverage;
 
 namespace Ui
 {
@@ -45,6 +48,8 @@ private:
     Ui::Event7 *ui;
     EventModel *model;
     std::vector<Profile7> profiles;
+    std::shared_ptr<ResultCache<EventResult>> cache;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModel();
 
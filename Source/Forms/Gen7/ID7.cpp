@@ -22,15 +22,19 @@
 #include <Core/Gen7/IDSearcher7.hpp>
 #include <Core/Parents/IDResult.hpp>
 #include <Core/Parents/ProfileLoader.hpp>
+#include <Core/Parents/SearchHistogram.hpp>
 #include <Core/Util/IDType.hpp>
+#include <Core/Util/TimeMask.hpp>
+#include <Core/Util/Utility.hpp>
 #include <Forms/Gen7/ProfileManager7.hpp>
 #include <Forms/Models/IDModel.hpp>
+#include <QDateTime>
 #include <QMessageBox>
 #include <QSettings>
 #include <QThread>
 #include <QTimer>
 
-ID7::ID7(QWidget *parent) : QWidget(parent), ui(new Ui::ID7)
+ID7::ID7(QWidget *parent) : QWidget(parent), ui(new Ui::ID7), coverage(std::make_shared<SearchCoverage>())
 {
     ui->setupUi(this);
     setAttribute(Qt::WA_QuitOnClose, false);
@@ -76,6 +80,9 @@ void ID7::setupModel()
 
     ui->textBoxStartFrame->setValues(InputType::Frame32Bit);
     ui->textBoxEndFrame->setValues(InputType::Frame32Bit);
+    ui->textBoxResultLimit->setValues(InputType::Delay);
+    ui->checkListWeekdays->setup({ "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" });
+    ui->hitCalendar->hide();
 
     ui->dateTimeEditStartDate->setCalendarPopup(true);
     ui->dateTimeEditEndDate->setCalendarPopup(true);
@@ -117,9 +124,19 @@ void ID7::search()
         return;
     }
 
-    model->clearModel();
+    TimeMask mask;
+    mask.setWeekdays(ui->checkListWeekdays->getChecked());
+    if (!mask.addTimes(ui->lineEditTimeMask->text().toStdString()))
+    {
+        QMessageBox error;
+        error.setText("Set allowed times like 18:00-23:00, 7-9");
+        error.exec();
+        return;
+    }
+
     ui->pushButtonSearch->setEnabled(false);
     ui->pushButtonCancel->setEnabled(true);
+    ui->pushButtonPause->setEnabled(true);
 
     IDType type;
     if (ui->radioButtonTID->isChecked())
@@ -141,21 +158,71 @@ void ID7::search()
 
     IDFilter filter(ui->textEditFilter->toPlainText().toStdString(), ui->textEditTSVFilter->toPlainText().toStdString(), type);
 
+    std::vector<u32> pids;
+    for (const QString &line : ui->textEditPIDFilter->toPlainText().split('\n', Qt::SkipEmptyParts))
+    {
+        bool flag;
+        u32 pid = line.trimmed().toUInt(&flag, 16);
+        if (flag)
+        {
+            pids.emplace_back(pid);
+        }
+    }
+
     auto *searcher = new IDSearcher7(start, end, frameStart, frameEnd, profiles[ui->comboBoxProfiles->currentIndex()], filter);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    searcher->setTargetPIDs(pids);
+    searcher->setOffsetDeltas(Utility::getOffsetDeltas(ui->lineEditOffsetDeltas->text().toStdString()));
+    auto cancel = connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    auto pause = connect(ui->pushButtonPause, &QPushButton::toggled, this, [=](bool checked) {
+        if (checked)
+        {
+            searcher->pauseSearch();
+        }
+        else
+        {
+            searcher->resumeSearch();
+        }
+        ui->pushButtonPause->setText(checked ? "Resume" : "Pause");
+    });
 
-    ui->progressBar->setRange(0, searcher->getMaxProgress());
+    ui->progressBar->setStats(searcher->getStats());
 
     QSettings settings;
     int threads = settings.value("settings/threads", QThread::idealThreadCount()).toInt();
+    searcher->loadSeedIndex(settings.value("settings/indexes").toString().toStdString());
+    searcher->setSearchCoverage(coverage);
+    searcher->setJournalPath(QString("%1/id7.journal").arg(settings.value("settings/journals").toString()).toStdString());
+    searcher->setResultLimit(ui->textBoxResultLimit->getUInt());
+    searcher->setTimeMask(mask);
+    if (ui->checkBoxNearest->isChecked())
+    {
+        QDateTime now = QDateTime::currentDateTime();
+        searcher->setAnchor(DateTime(now.date().toJulianDay(), now.time().msecsSinceStartOfDay() / 1000), 0);
+    }
+
+    // Hit counts replace the results table with a calendar of when the hits are
+    std::shared_ptr<SearchHistogram> histogram;
+    if (ui->checkBoxAggregate->isChecked())
+    {
+        histogram = std::make_shared<SearchHistogram>();
+        searcher->setHistogram(histogram);
+        ui->hitCalendar->clearHistogram();
+    }
+    ui->tableView->setVisible(!histogram);
+    ui->hitCalendar->setVisible(histogram != nullptr);
+
+    // Widening the range of the last search only adds the results of the new part
+    if (!searcher->isIncremental())
+    {
+        model->clearModel();
+    }
 
     auto *thread = QThread::create([=] { searcher->startSearch(threads); });
     connect(thread, &QThread::finished, thread, &QThread::deleteLater);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, [searcher] { searcher->cancelSearch(); });
 
     auto *timer = new QTimer();
     connect(timer, &QTimer::timeout, [=] {
-        ui->progressBar->setValue(searcher->getProgress());
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
     });
     connect(thread, &QThread::finished, timer, &QTimer::stop);
@@ -163,8 +230,21 @@ void ID7::search()
     connect(timer, &QTimer::destroyed, [=] {
         ui->pushButtonSearch->setEnabled(true);
         ui->pushButtonCancel->setEnabled(false);
-        ui->progressBar->setValue(searcher->getProgress());
+        QObject::disconnect(cancel);
+        QObject::disconnect(pause);
+        ui->pushButtonPause->setChecked(false);
+        ui->pushButtonPause->setText("Pause");
+        ui->pushButtonPause->setEnabled(false);
+        ui->progressBar->setStats(searcher->getStats());
         model->addItems(searcher->getResults());
+        if (!pids.empty())
+        {
+            model->sortByShinyCount();
+        }
+        if (histogram)
+        {
+            ui->hitCalendar->setHistogram(*histogram);
+        }
         delete searcher;
     });
 
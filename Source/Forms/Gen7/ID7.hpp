@@ -21,9 +21,11 @@
 #define ID7_HPP
 
 #include <QWidget>
+#include <memory>
 
 class IDModel;
 class Profile7;
+class SearchCoverage;
 
 namespace Ui
 {
@@ -45,6 +47,7 @@ private:
     Ui::ID7 *ui;
     IDModel *model;
     std::vector<Profile7> profiles;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModel();
 
@@ -94,13 +94,12 @@ void ProfileCalibrater7::search()
     u32 offsetRange = ui->textBoxOffsetRange->getUInt();
 
     auto *searcher = new ProfileSearcher7(dateTime, initialSeed, baseTick, baseOffset, tickRange, offsetRange);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
+    auto cancel = connect(ui->pushButtonCancel, &QPushButton::clicked, this, [=] { searcher->cancelSearch(); });
 
     ui->progressBar->setRange(0, searcher->getMaxProgress());
 
     auto *thread = QThread::create([=] { searcher->startSearch(); });
     connect(thread, &QThread::finished, thread, &QThread::deleteLater);
-    connect(ui->pushButtonCancel, &QPushButton::clicked, [searcher] { searcher->cancelSearch(); });
 
     auto *timer = new QTimer();
     connect(timer, &QTimer::timeout, [=] {
@@ -116,6 +115,7 @@ void ProfileCalibrater7::search()
     connect(timer, &QTimer::destroyed, [=] {
         ui->pushButtonSearch->setEnabled(true);
         ui->pushButtonCancel->setEnabled(false);
+        QObject::disconnect(cancel);
 
         ui->progressBar->setValue(searcher->getProgress());
         auto results = searcher->getResults();
@@ -20,10 +20,13 @@
 #ifndef STATIONARY7_HPP
 #define STATIONARY7_HPP
 
+#include <Core/Parents/ResultCache.hpp>
 #include <QWidget>
 
 class Profile7;
+class SearchCoverage;
 class StationaryModel;
+class StationaryResult;
 
 namespace Ui
 {
@@ -45,6 +48,8 @@ private:
     Ui::Stationary7 *ui;
     StationaryModel *model;
     std::vector<Profile7> profiles;
+    std::shared_ptr<ResultCache<StationaryResult>> cache;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModel();
 
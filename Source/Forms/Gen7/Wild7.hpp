@@ -20,10 +20,13 @@
 #ifndef WILD7_HPP
 #define WILD7_HPP
 
+#include <Core/Parents/ResultCache.hpp>
 #include <QWidget>
 
 class Profile7;
+class SearchCoverage;
 class WildModel;
+class WildResult;
 
 namespace Ui
 {
@@ -45,6 +48,8 @@ private:
     Ui::Wild7 *ui;
     WildModel *model;
     std::vector<Profile7> profiles;
+    std::shared_ptr<ResultCache<WildResult>> cache;
+    std::shared_ptr<SearchCoverage> coverage;
 
     void setupModel();
 
@@ -19,6 +19,9 @@
 
 #include "MainWindow.hpp"
 #include "ui_MainWindow.h"
+#include <Core/Gen7/Profile7.hpp>
+#include <Core/Gen7/SeedCalendar7.hpp>
+#include <Core/Parents/ProfileLoader.hpp>
 #include <Forms/Gen6/Event6.hpp>
 #include <Forms/Gen6/Stationary6.hpp>
 #include <Forms/Gen7/Event7.hpp>
@@ -28,14 +31,25 @@
 #include <Forms/Gen7/Wild7.hpp>
 #include <QActionGroup>
 #include <QClipboard>
+#include <QDate>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QProcess>
 #include <QSettings>
 #include <QThread>
 #include <QTimer>
+#include <thread>
 #include <version.h>
 
+namespace
+{
+    // Calendars are per tick and offset, named like their files
+    QString getCalendarKey(const Profile7 &profile)
+    {
+        return QString("%1_%2").arg(profile.getTick(), 8, 16, QChar('0')).arg(profile.getOffset());
+    }
+}
+
 MainWindow::MainWindow(bool profile, QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
@@ -44,6 +58,7 @@ MainWindow::MainWindow(bool profile, QWidget *parent) : QMainWindow(parent), ui(
     setupModel();
     setupStyle();
     setupThread();
+    setupCalendars();
 
     QTimer::singleShot(1000, this, [profile] {
         if (!profile)
@@ -61,6 +76,12 @@ MainWindow::~MainWindow()
     settings.setValue("settings/style", currentStyle);
     settings.setValue("mainWindow/geometry", this->saveGeometry());
 
+    // The builder holds its own references to the calendars, it stops after the day it is on without being waited for
+    if (calendarCancel)
+    {
+        *calendarCancel = true;
+    }
+
     delete ui;
 }
 
@@ -75,6 +96,7 @@ void MainWindow::setupModel()
     connect(ui->actionProfiles, &QAction::triggered, this, &MainWindow::updateProfilePath);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::openAbout);
     connect(ui->actionCalibrator7, &QAction::triggered, this, &MainWindow::openCalibrator7);
+    connect(ui->menuCalendars, &QMenu::triggered, this, &MainWindow::slotCalendarChanged);
 
     QSettings setting;
     if (setting.contains("mainWindow/geometry"))
@@ -135,6 +157,76 @@ void MainWindow::setupThread()
     }
 }
 
+void MainWindow::setupCalendars()
+{
+    QSettings setting;
+    QStringList enabled = setting.value("settings/calendarprofiles").toStringList();
+
+    // Each calendar is over 100 MB, so only the profiles checked in the menu get one
+    ui->menuCalendars->clear();
+    QStringList keys;
+    for (const auto &profile : ProfileLoader7::getProfiles())
+    {
+        QString key = getCalendarKey(profile);
+        if (!keys.contains(key))
+        {
+            keys.append(key);
+
+            QAction *action = ui->menuCalendars->addAction(QString::fromStdString(profile.getName()));
+            action->setData(key);
+            action->setCheckable(true);
+            action->setChecked(enabled.contains(key));
+        }
+    }
+
+    buildCalendars();
+}
+
+void MainWindow::buildCalendars()
+{
+    QSettings setting;
+    std::string directory = setting.value("settings/calendars").toString().toStdString();
+    int years = setting.value("settings/calendaryears", 1).toInt();
+    QStringList enabled = setting.value("settings/calendarprofiles").toStringList();
+
+    // Calendars start at the beginning of the current year so they cover the dates most searches use
+    int year = QDate::currentDate().year();
+    Date start(year, 1, 1);
+    u32 days = start.daysTo(Date(year + years, 1, 1));
+
+    calendars.clear();
+    for (const auto &profile : ProfileLoader7::getProfiles())
+    {
+        if (enabled.removeAll(getCalendarKey(profile)) > 0)
+        {
+            if (auto calendar = SeedCalendar7::open(directory, profile.getTick(), profile.getOffset(), start, days))
+            {
+                calendars.emplace_back(calendar);
+            }
+        }
+    }
+
+    // A previous builder is only told to stop, it finishes the day it is on in the background
+    if (calendarCancel)
+    {
+        *calendarCancel = true;
+    }
+    calendarCancel = std::make_shared<std::atomic_bool>(false);
+
+    // One thread builds the calendars one after another so searches keep the rest of the cores
+    if (!calendars.empty())
+    {
+        std::thread([calendars = calendars, cancel = calendarCancel] {
+            for (const auto &calendar : calendars)
+            {
+                while (!*cancel && calendar->buildNextDay())
+                {
+                }
+            }
+        }).detach();
+    }
+}
+
 void MainWindow::slotStyleChanged(QAction *action)
 {
     if (action)
@@ -169,6 +261,25 @@ void MainWindow::slotThreadChanged(QAction *action)
     }
 }
 
+void MainWindow::slotCalendarChanged(QAction *action)
+{
+    if (action)
+    {
+        QSettings setting;
+        QStringList enabled = setting.value("settings/calendarprofiles").toStringList();
+
+        QString key = action->data().toString();
+        enabled.removeAll(key);
+        if (action->isChecked())
+        {
+            enabled.append(key);
+        }
+        setting.setValue("settings/calendarprofiles", enabled);
+
+        buildCalendars();
+    }
+}
+
 void MainWindow::updateProfilePath()
 {
     QSettings setting;
@@ -212,6 +323,8 @@ void MainWindow::updateProfiles(int num)
     }
     else
     {
+        setupCalendars();
+
         if (event7)
         {
             event7->updateProfiles();
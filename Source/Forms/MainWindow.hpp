@@ -21,12 +21,16 @@
 #define MAINWINDOW_HPP
 
 #include <QMainWindow>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 class Event6;
 class Stationary6;
 class Event7;
 class ID7;
 class QActionGroup;
+class SeedCalendar7;
 class Stationary7;
 class Wild7;
 
@@ -54,14 +58,19 @@ private:
     ID7 *id7 = nullptr;
     Stationary7 *stationary7 = nullptr;
     Wild7 *wild7 = nullptr;
+    std::vector<std::shared_ptr<SeedCalendar7>> calendars;
+    std::shared_ptr<std::atomic_bool> calendarCancel;
 
     void setupModel();
     void setupStyle();
     void setupThread();
+    void setupCalendars();
+    void buildCalendars();
 
 private slots:
     void slotStyleChanged(QAction *action);
     void slotThreadChanged(QAction *action);
+    void slotCalendarChanged(QAction *action);
     void updateProfilePath();
     void updateProfiles(int num);
     void openEvent6();
@@ -40,7 +40,15 @@ QVariant EventModel::data(const QModelIndex &index, int role) const
         switch (column)
         {
         case 0:
-            return QString::fromStdString(frame.getDateTime());
+        {
+            QString dateTime = QString::fromStdString(frame.getDateTime());
+            int delta = frame.getOffsetDelta();
+            if (delta != 0)
+            {
+                return QString("%1 (%2 ms)").arg(dateTime, delta > 0 ? QString("+%1").arg(delta) : QString::number(delta));
+            }
+            return dateTime;
+        }
         case 1:
             return QString::number(frame.getSeed(), 16).toUpper();
         case 2:
@@ -19,6 +19,7 @@
 
 #include "IDModel.hpp"
 #include <Core/Parents/IDResult.hpp>
+#include <algorithm>
 
 IDModel::IDModel(QObject *parent) : TableModel<IDResult>(parent)
 {
@@ -27,7 +28,7 @@ IDModel::IDModel(QObject *parent) : TableModel<IDResult>(parent)
 int IDModel::columnCount(const QModelIndex &parent) const
 {
     (void)parent;
-    return 7;
+    return 8;
 }
 
 QVariant IDModel::data(const QModelIndex &index, int role) const
@@ -38,7 +39,15 @@ QVariant IDModel::data(const QModelIndex &index, int role) const
         switch (index.column())
         {
         case 0:
-            return QString::fromStdString(frame.getDateTime());
+        {
+            QString dateTime = QString::fromStdString(frame.getDateTime());
+            int delta = frame.getOffsetDelta();
+            if (delta != 0)
+            {
+                return QString("%1 (%2 ms)").arg(dateTime, delta > 0 ? QString("+%1").arg(delta) : QString::number(delta));
+            }
+            return dateTime;
+        }
         case 1:
             return QString::number(frame.getSeed(), 16).toUpper();
         case 2:
@@ -51,6 +60,8 @@ QVariant IDModel::data(const QModelIndex &index, int role) const
             return frame.getSID();
         case 6:
             return frame.getTSV();
+        case 7:
+            return frame.getShinyCount();
         }
     }
     return QVariant();
@@ -64,3 +75,11 @@ QVariant IDModel::headerData(int section, Qt::Orientation orientation, int role)
     }
     return QVariant();
 }
+
+void IDModel::sortByShinyCount()
+{
+    emit layoutAboutToBeChanged();
+    std::stable_sort(model.begin(), model.end(),
+                     [](const IDResult &left, const IDResult &right) { return left.getShinyCount() > right.getShinyCount(); });
+    emit layoutChanged();
+}
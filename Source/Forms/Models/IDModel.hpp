@@ -31,9 +31,10 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    void sortByShinyCount();
 
 private:
-    QStringList header = { "Date/Time", "Initial Seed", "Frame", "G7 TID", "TID", "SID", "TSV" };
+    QStringList header = { "Date/Time", "Initial Seed", "Frame", "G7 TID", "TID", "SID", "TSV", "Shinies" };
 };
 
 #endif // IDMODEL_HPP
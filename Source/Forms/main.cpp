@@ -35,6 +35,24 @@ void validateSettings(QSettings &setting)
         setting.setValue("settings/profiles", QString("%1/profiles.json").arg(documentFolder));
     }
 
+    if (!setting.contains("settings/calendars"))
+    {
+        QString documentFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        setting.setValue("settings/calendars", QString("%1/calendars").arg(documentFolder));
+    }
+
+    if (!setting.contains("settings/indexes"))
+    {
+        QString documentFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        setting.setValue("settings/indexes", QString("%1/indexes").arg(documentFolder));
+    }
+
+    if (!setting.contains("settings/journals"))
+    {
+        QString documentFolder = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        setting.setValue("settings/journals", QString("%1/journals").arg(documentFolder));
+    }
+
     if (!setting.contains("settings/style"))
     {
         setting.setValue("settings/style", "dark");
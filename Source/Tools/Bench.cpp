@@ -0,0 +1,409 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "Verify.hpp"
+#include <Core/Gen6/EventSearcher6.hpp>
+#include <Core/Gen6/StationarySearcher6.hpp>
+#include <Core/Gen7/EventSearcher7.hpp>
+#include <Core/Gen7/IDSearcher7.hpp>
+#include <Core/Gen7/StationarySearcher7.hpp>
+#include <Core/Gen7/WildSearcher7.hpp>
+#include <Core/RNG/MT.hpp>
+#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/SFMT.hpp>
+#include <Core/Util/Game.hpp>
+#include <Core/Util/IDType.hpp>
+#include <Core/Util/PIDType.hpp>
+#include <Core/Util/Utility.hpp>
+#include <Core/Util/WildType.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace
+{
+    struct Benchmark
+    {
+        std::string name;
+        std::string unit;
+        std::function<u64()> workload;
+    };
+
+    struct Settings
+    {
+        int threads = static_cast<int>(std::thread::hardware_concurrency());
+        int repetitions = 3;
+        bool quick = false;
+        bool verify = false;
+        u32 seed = std::random_device()();
+        int iterations = 200;
+        std::string filter;
+        std::string output;
+        std::string baseline;
+        double tolerance = 10;
+    };
+
+    // Results are folded into this so the compiler can't drop the work being timed
+    volatile u64 sink;
+
+    const Profile6 profile6("Bench", 0x12345678, 0x9abcdef0, 12345, 54321, Game::X, false);
+    const Profile7 profile7("Bench", 55, 0x41D9CB9, 12345, 54321, Game::UltraSun, false);
+
+    template <class Filter>
+    Filter getFilter(u8 minIV, u8 shiny)
+    {
+        std::array<u8, 6> min = { minIV, minIV, minIV, minIV, minIV, minIV };
+        std::array<u8, 6> max = { 31, 31, 31, 31, 31, 31 };
+        std::vector<bool> natures(25, true);
+        std::vector<bool> hiddenPowers(16, true);
+
+        if constexpr (std::is_same_v<Filter, WildFilter>)
+        {
+            return WildFilter(min, max, natures, hiddenPowers, std::vector<bool>(10, true), 255, shiny, 255);
+        }
+        else
+        {
+            return Filter(min, max, natures, hiddenPowers, 255, shiny, 255);
+        }
+    }
+
+    // Searchers report frames per second over one day, or one hour in quick mode, at frames 0 to 1000
+    template <class Searcher>
+    u64 runSearcher(Searcher &searcher, int threads)
+    {
+        searcher.startSearch(threads);
+        sink = sink + searcher.getResults().size();
+        return searcher.getStats().frames;
+    }
+
+    std::vector<Benchmark> getBenchmarks(const Settings &settings)
+    {
+        DateTime start(2020, 1, 1, 0, 0, 0);
+        DateTime end = settings.quick ? DateTime(2020, 1, 1, 0, 59, 59) : DateTime(2020, 1, 1, 23, 59, 59);
+        int threads = settings.threads;
+
+        return {
+            { "sfmt.init", "seeds/s",
+              [] {
+                  constexpr u32 count = 200000;
+                  for (u32 seed = 0; seed < count; seed++)
+                  {
+                      SFMT sfmt(seed);
+                      sink = sink + sfmt.next();
+                  }
+                  return count;
+              } },
+            { "sfmt.next", "words/s",
+              [] {
+                  constexpr u32 count = 50000000;
+                  SFMT sfmt(0x12345678);
+                  u64 value = 0;
+                  for (u32 i = 0; i < count; i++)
+                  {
+                      value ^= sfmt.next();
+                  }
+                  sink = sink + value;
+                  return count * 2ull;
+              } },
+            { "mt.init", "seeds/s",
+              [] {
+                  constexpr u32 count = 200000;
+                  for (u32 seed = 0; seed < count; seed++)
+                  {
+                      MT mt(seed);
+                      sink = sink + mt.next();
+                  }
+                  return count;
+              } },
+            { "mt.next", "words/s",
+              [] {
+                  constexpr u32 count = 100000000;
+                  MT mt(0x12345678);
+                  u32 value = 0;
+                  for (u32 i = 0; i < count; i++)
+                  {
+                      value ^= mt.next();
+                  }
+                  sink = sink + value;
+                  return count;
+              } },
+            { "rnglist.sfmt", "values/s",
+              [] {
+                  constexpr u32 count = 50000000;
+                  SFMT sfmt(0x12345678);
+                  RNGList<u64, SFMT, 64> rngList(sfmt);
+                  u64 value = 0;
+                  for (u32 i = 0; i < count; i++, rngList.advanceState())
+                  {
+                      value ^= rngList.getValue();
+                  }
+                  sink = sink + value;
+                  return count;
+              } },
+            { "sha256.hash", "hashes/s",
+              [] {
+                  constexpr u32 count = 2000000;
+                  u32 value = 0;
+                  for (u64 epoch = 0; epoch < count; epoch++)
+                  {
+                      value ^= Utility::calcInitialSeed(0x41D9CB9, 0x2c00000000ull + epoch * 1000);
+                  }
+                  sink = sink + value;
+                  return count;
+              } },
+            { "sha256.batch", "hashes/s",
+              [] {
+                  constexpr u32 count = 2000000;
+                  constexpr u32 batch = 256;
+                  u64 epochs[batch];
+                  u32 seeds[batch];
+                  u32 value = 0;
+                  for (u64 epoch = 0; epoch < count; epoch += batch)
+                  {
+                      for (u32 i = 0; i < batch; i++)
+                      {
+                          epochs[i] = 0x2c00000000ull + (epoch + i) * 1000;
+                      }
+                      Utility::calcInitialSeeds(0x41D9CB9, epochs, batch, seeds);
+                      value ^= seeds[batch - 1];
+                  }
+                  sink = sink + value;
+                  return count;
+              } },
+            { "stationary6.shiny", "frames/s",
+              [=] {
+                  StationarySearcher6 searcher(start, end, 0, 1000, false, 255, 0, 255, false, false, profile6,
+                                               getFilter<StationaryFilter>(0, 1));
+                  return runSearcher(searcher, threads);
+              } },
+            { "stationary6.6iv", "frames/s",
+              [=] {
+                  StationarySearcher6 searcher(start, end, 0, 1000, false, 255, 0, 255, false, false, profile6,
+                                               getFilter<StationaryFilter>(31, 255));
+                  return runSearcher(searcher, threads);
+              } },
+            { "event6.6iv", "frames/s",
+              [=] {
+                  EventSearcher6 searcher(start, end, 0, 1000, 0, PIDType::Random, profile6, getFilter<EventFilter>(31, 255));
+                  return runSearcher(searcher, threads);
+              } },
+            { "stationary7.shiny", "frames/s",
+              [=] {
+                  StationarySearcher7 searcher(start, end, 0, 1000, false, 255, 0, 255, false, false, profile7,
+                                               getFilter<StationaryFilter>(0, 1));
+                  return runSearcher(searcher, threads);
+              } },
+            { "stationary7.6iv", "frames/s",
+              [=] {
+                  StationarySearcher7 searcher(start, end, 0, 1000, false, 255, 0, 255, false, false, profile7,
+                                               getFilter<StationaryFilter>(31, 255));
+                  return runSearcher(searcher, threads);
+              } },
+            { "wild7.6iv", "frames/s",
+              [=] {
+                  WildSearcher7 searcher(start, end, 0, 1000, false, 0, WildType::Grass, 255, profile7, getFilter<WildFilter>(31, 255));
+                  return runSearcher(searcher, threads);
+              } },
+            { "event7.6iv", "frames/s",
+              [=] {
+                  EventSearcher7 searcher(start, end, 0, 1000, 0, PIDType::Random, profile7, getFilter<EventFilter>(31, 255));
+                  return runSearcher(searcher, threads);
+              } },
+            { "id7.tsv", "frames/s",
+              [=] {
+                  IDSearcher7 searcher(start, end, 0, 1000, profile7, IDFilter("", "1234", IDType::TID));
+                  return runSearcher(searcher, threads);
+              } },
+        };
+    }
+
+    // Keeps the fastest of the repetitions, slower runs are mostly noise from the rest of the system
+    json runBenchmark(const Benchmark &benchmark, int repetitions)
+    {
+        double bestRate = 0;
+        double bestSeconds = 0;
+        for (int i = 0; i < repetitions; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            u64 units = benchmark.workload();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double rate = seconds > 0 ? units / seconds : 0;
+            if (rate > bestRate)
+            {
+                bestRate = rate;
+                bestSeconds = seconds;
+            }
+        }
+
+        json result;
+        result["name"] = benchmark.name;
+        result["unit"] = benchmark.unit;
+        result["rate"] = bestRate;
+        result["seconds"] = bestSeconds;
+        return result;
+    }
+
+    // Returns how many benchmarks are slower than the baseline by more than the tolerance
+    int compareBaseline(const json &report, const json &baseline, double tolerance)
+    {
+        std::map<std::string, double> rates;
+        for (const auto &result : baseline["benchmarks"])
+        {
+            rates[result["name"].get<std::string>()] = result["rate"].get<double>();
+        }
+
+        int regressions = 0;
+        for (const auto &result : report["benchmarks"])
+        {
+            auto it = rates.find(result["name"].get<std::string>());
+            if (it == rates.end() || it->second <= 0)
+            {
+                continue;
+            }
+
+            double change = (result["rate"].get<double>() / it->second - 1) * 100;
+            bool regressed = change < -tolerance;
+            std::cerr << (regressed ? "REGRESSION " : "ok         ") << result["name"].get<std::string>() << " " << change << "%"
+                      << std::endl;
+            regressions += regressed;
+        }
+        return regressions;
+    }
+
+    bool parseArguments(int argc, char *argv[], Settings &settings)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--quick")
+            {
+                settings.quick = true;
+            }
+            else if (argument == "--verify")
+            {
+                settings.verify = true;
+            }
+            else if (argument == "--seed" && hasValue)
+            {
+                settings.seed = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (argument == "--iterations" && hasValue)
+            {
+                settings.iterations = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (argument == "--threads" && hasValue)
+            {
+                settings.threads = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (argument == "--repetitions" && hasValue)
+            {
+                settings.repetitions = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (argument == "--filter" && hasValue)
+            {
+                settings.filter = argv[++i];
+            }
+            else if (argument == "--output" && hasValue)
+            {
+                settings.output = argv[++i];
+            }
+            else if (argument == "--baseline" && hasValue)
+            {
+                settings.baseline = argv[++i];
+            }
+            else if (argument == "--tolerance" && hasValue)
+            {
+                settings.tolerance = std::atof(argv[++i]);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::cerr << "Usage: 3DSTimeFinderBench [--quick] [--threads n] [--repetitions n] [--filter text] [--output file.json]"
+                  << " [--baseline file.json] [--tolerance percent]" << std::endl;
+        std::cerr << "       3DSTimeFinderBench --verify [--seed n] [--iterations n] [--threads n]" << std::endl;
+        return 1;
+    }
+
+    if (settings.verify)
+    {
+        return Verify::run(settings.seed, settings.iterations, settings.threads) ? 0 : 1;
+    }
+
+    json report;
+    report["threads"] = settings.threads;
+    report["quick"] = settings.quick;
+    report["benchmarks"] = json::array();
+
+    for (const auto &benchmark : getBenchmarks(settings))
+    {
+        if (!settings.filter.empty() && benchmark.name.find(settings.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        json result = runBenchmark(benchmark, settings.repetitions);
+        std::cerr << benchmark.name << ": " << result["rate"].get<double>() << " " << benchmark.unit << std::endl;
+        report["benchmarks"].emplace_back(result);
+    }
+
+    if (settings.output.empty())
+    {
+        std::cout << report.dump(4) << std::endl;
+    }
+    else
+    {
+        std::ofstream write(settings.output);
+        write << report.dump(4) << std::endl;
+    }
+
+    if (!settings.baseline.empty())
+    {
+        std::ifstream read(settings.baseline);
+        json baseline = json::parse(read, nullptr, false);
+        if (baseline.is_discarded() || !baseline.contains("benchmarks"))
+        {
+            std::cerr << "Unable to read baseline " << settings.baseline << std::endl;
+            return 1;
+        }
+        return compareBaseline(report, baseline, settings.tolerance) == 0 ? 0 : 2;
+    }
+    return 0;
+}
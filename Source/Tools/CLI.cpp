@@ -0,0 +1,579 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <Core/Parents/BatchSearcher.hpp>
+#include <Core/RNG/MT.hpp>
+#include <Core/RNG/SFMT.hpp>
+#include <Tools/Job.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <thread>
+
+using json = nlohmann::ordered_json;
+
+namespace
+{
+    struct Settings
+    {
+        std::vector<std::string> jobs;
+        std::string output;
+        std::string trace;
+        std::string journal;
+        std::string cards;
+        std::string anchor;
+        std::string histogram;
+        int threads = static_cast<int>(std::thread::hardware_concurrency());
+        u32 first = 0;
+        u64 radius = 0;
+        bool csv = false;
+        bool progress = false;
+    };
+
+    volatile std::sig_atomic_t interrupted = 0;
+
+    std::string getHex(u32 value)
+    {
+        char text[9];
+        std::snprintf(text, sizeof(text), "%08x", value);
+        return text;
+    }
+
+    json getRow(const IDResult &result)
+    {
+        json row;
+        row["date"] = result.getDateTime();
+        row["offsetDelta"] = result.getOffsetDelta();
+        row["seed"] = getHex(result.getSeed());
+        row["frame"] = result.getFrame();
+        row["tid"] = result.getTID();
+        row["sid"] = result.getSID();
+        row["tsv"] = result.getTSV();
+        row["displayTID"] = result.getDisplayTID();
+        row["shinyCount"] = result.getShinyCount();
+        return row;
+    }
+
+    template <class ResultType>
+    json getRow(const ResultType &result)
+    {
+        json row;
+        row["date"] = result.getDateTime();
+        row["offsetDelta"] = result.getOffsetDelta();
+        row["seed"] = getHex(result.getSeed());
+        row["frame"] = result.getFrame();
+        row["pid"] = getHex(result.getPID());
+        row["ec"] = getHex(result.getEC());
+        row["shiny"] = result.getShiny() != 0;
+        const char *stats[6] = { "hp", "atk", "def", "spa", "spd", "spe" };
+        for (u8 i = 0; i < 6; i++)
+        {
+            row[stats[i]] = result.getIV(i);
+        }
+        row["hiddenPower"] = Utility::getHiddenPower(result.getHiddenPower());
+        row["nature"] = Utility::getNature(result.getNature());
+        row["ability"] = result.getAbility();
+        row["gender"] = result.getGender();
+        if constexpr (std::is_same_v<ResultType, WildResult>)
+        {
+            row["encounterSlot"] = result.getEncounterSlot();
+            row["synch"] = result.getSynch();
+        }
+        else if constexpr (std::is_same_v<ResultType, StationaryResult>)
+        {
+            row["encounter"] = result.getEncounter();
+        }
+        return row;
+    }
+
+    // A second of a seed list job and the seed it hashes to
+    json getRow(const std::pair<DateTime, u32> &result)
+    {
+        json row;
+        row["date"] = result.first.toString();
+        row["seed"] = getHex(result.second);
+        return row;
+    }
+
+    // An hour or day of a histogram, start is in seconds since 1970
+    struct HistogramRow
+    {
+        u64 start;
+        bool day;
+        HistogramBucket bucket;
+    };
+
+    json getRow(const HistogramRow &result)
+    {
+        DateTime start(result.start * 1000);
+        json row;
+        row["date"] = result.day ? start.getDate().toString() : start.toString();
+        row["hits"] = result.bucket.hits;
+        row["bestDate"] = DateTime(result.bucket.bestTime * 1000).toString();
+        row["bestOffsetDelta"] = result.bucket.bestDelta;
+        row["bestSeed"] = getHex(result.bucket.bestSeed);
+        row["bestFrame"] = result.bucket.bestFrame;
+        return row;
+    }
+
+    // Writes JSON lines, or CSV with a header taken from the first row. Rows of a batch start with the job or card they belong to.
+    class ResultWriter
+    {
+    public:
+        ResultWriter(std::ostream &stream, bool csv) : stream(stream), csv(csv), header(false), count(0)
+        {
+        }
+
+        template <class ResultType>
+        void write(const std::vector<ResultType> &results, const json &tag = json())
+        {
+            // Jobs of a batch publish from their own locks, so writes are serialized here
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto &result : results)
+            {
+                json row = tag.is_object() ? tag : json::object();
+                row.update(getRow(result));
+                if (!csv)
+                {
+                    stream << row.dump() << '\n';
+                    continue;
+                }
+
+                if (!header)
+                {
+                    writeCSV(row, true);
+                    header = true;
+                }
+                writeCSV(row, false);
+            }
+            count += results.size();
+            stream.flush();
+        }
+
+        u64 getCount() const
+        {
+            return count;
+        }
+
+    private:
+        std::ostream &stream;
+        bool csv;
+        bool header;
+        std::atomic<u64> count;
+        std::mutex mutex;
+
+        void writeCSV(const json &row, bool keys)
+        {
+            bool first = true;
+            for (const auto &[key, value] : row.items())
+            {
+                stream << (first ? "" : ",") << (keys ? key : value.is_string() ? value.get<std::string>() : value.dump());
+                first = false;
+            }
+            stream << '\n';
+        }
+    };
+
+    bool parseArguments(int argc, char *argv[], Settings &settings)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--threads" && hasValue)
+            {
+                settings.threads = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (argument == "--output" && hasValue)
+            {
+                settings.output = argv[++i];
+            }
+            else if (argument == "--cards" && hasValue)
+            {
+                settings.cards = argv[++i];
+            }
+            else if (argument == "--trace" && hasValue)
+            {
+                settings.trace = argv[++i];
+            }
+            else if (argument == "--journal" && hasValue)
+            {
+                settings.journal = argv[++i];
+            }
+            else if (argument == "--first" && hasValue)
+            {
+                settings.first = static_cast<u32>(std::max(0, std::atoi(argv[++i])));
+            }
+            else if (argument == "--anchor" && hasValue)
+            {
+                settings.anchor = argv[++i];
+            }
+            else if (argument == "--radius" && hasValue)
+            {
+                settings.radius = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (argument == "--histogram" && hasValue
+                     && (std::strcmp(argv[i + 1], "hours") == 0 || std::strcmp(argv[i + 1], "days") == 0))
+            {
+                settings.histogram = argv[++i];
+            }
+            else if (argument == "--csv")
+            {
+                settings.csv = true;
+            }
+            else if (argument == "--progress")
+            {
+                settings.progress = true;
+            }
+            else if (argument == "-" || argument[0] != '-')
+            {
+                settings.jobs.emplace_back(argument);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return !settings.jobs.empty();
+    }
+
+    // Options that only apply to a single search job, anything else rejects them instead of ignoring them
+    std::string getSingleJobOption(const Settings &settings)
+    {
+        if (!settings.trace.empty())
+        {
+            return "--trace";
+        }
+        if (!settings.journal.empty())
+        {
+            return "--journal";
+        }
+        if (settings.first != 0)
+        {
+            return "--first";
+        }
+        if (!settings.anchor.empty() || settings.radius != 0)
+        {
+            return "--anchor";
+        }
+        if (!settings.histogram.empty())
+        {
+            return "--histogram";
+        }
+        return "";
+    }
+
+    JobSearcher getJob(const std::string &path)
+    {
+        return path == "-" ? Job::readJob(std::cin, "stdin") : Job::loadJob(path);
+    }
+
+    // Waits for the search while watching for Ctrl+C, results are written by the workers
+    template <class Cancel, class Report>
+    void waitSearch(std::future<void> &search, const Settings &settings, Cancel cancel, Report report)
+    {
+        auto last = std::chrono::steady_clock::now();
+        while (search.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+        {
+            if (interrupted)
+            {
+                cancel();
+            }
+
+            if (settings.progress && std::chrono::steady_clock::now() - last >= std::chrono::seconds(1))
+            {
+                last = std::chrono::steady_clock::now();
+                report();
+            }
+        }
+        search.get();
+
+        if (settings.progress)
+        {
+            std::fprintf(stderr, "\n");
+        }
+    }
+
+    void runJob(JobSearcher &job, const Settings &settings, ResultWriter &writer)
+    {
+        std::visit(
+            [&](auto &searcher) {
+                using ResultType = typename decltype(searcher->getResults())::value_type;
+                searcher->setResultCallback([&writer](const std::vector<ResultType> &results) { writer.write(results); });
+                searcher->setTracePath(settings.trace);
+                searcher->setJournalPath(settings.journal);
+                searcher->setResultLimit(settings.first);
+
+                // Only the hit counts are written, once the search finishes
+                std::shared_ptr<SearchHistogram> histogram;
+                if (!settings.histogram.empty())
+                {
+                    histogram = std::make_shared<SearchHistogram>();
+                    searcher->setHistogram(histogram);
+                }
+
+                auto search = std::async(std::launch::async, [&] { searcher->startSearch(settings.threads); });
+                waitSearch(
+                    search, settings, [&] { searcher->cancelSearch(); },
+                    [&] {
+                        SearchStats stats = searcher->getStats();
+                        std::fprintf(stderr, "\r%.2f%% %.0f seeds/s %.0f frames/s %llu hits ETA %.0fs   ",
+                                     stats.maxProgress == 0 ? 100.0 : 100.0 * stats.progress / stats.maxProgress, stats.seedsPerSecond,
+                                     stats.framesPerSecond, stats.hits, stats.eta);
+                    });
+
+                if (histogram)
+                {
+                    bool days = settings.histogram == "days";
+                    std::vector<HistogramRow> rows;
+                    for (const auto &[bucket, counts] : days ? histogram->getDays() : histogram->getHours())
+                    {
+                        rows.push_back({ bucket * (days ? 86400 : 3600), days, counts });
+                    }
+                    writer.write(rows);
+                }
+            },
+            job);
+    }
+
+    // Dates are only known once the whole range is hashed, they are written sorted when the finder is done
+    void runSeedJob(SeedDateFinder7 &finder, const Settings &settings, ResultWriter &writer)
+    {
+        auto search = std::async(std::launch::async, [&] { finder.startSearch(settings.threads); });
+        waitSearch(
+            search, settings, [&] { finder.cancelSearch(); },
+            [&] {
+                u64 progress = finder.getProgress();
+                u64 maxProgress = finder.getMaxProgress();
+                std::fprintf(stderr, "\r%.2f%% %llu of %llu seconds   ", 100.0 * progress / maxProgress,
+                             static_cast<unsigned long long>(progress), static_cast<unsigned long long>(maxProgress));
+            });
+
+        auto results = finder.getResults();
+        std::sort(results.begin(), results.end(), [](const auto &left, const auto &right) { return left.first < right.first; });
+        writer.write(results);
+    }
+
+    // Creates one event job per valid wondercard of the directory, the job file supplies everything but the card
+    std::vector<JobSearcher> getCardJobs(const Settings &settings, std::vector<json> &tags)
+    {
+        if (settings.jobs.size() != 1 || settings.jobs.front() == "-")
+        {
+            throw std::runtime_error("--cards needs exactly one job file");
+        }
+
+        JobSearcher job = getJob(settings.jobs.front());
+        u8 generation = std::visit(
+            [](auto &searcher) -> u8 {
+                using SearcherType = typename std::decay_t<decltype(searcher)>::element_type;
+                if constexpr (std::is_same_v<SearcherType, EventSearcher6>)
+                {
+                    return 6;
+                }
+                else if constexpr (std::is_same_v<SearcherType, EventSearcher7>)
+                {
+                    return 7;
+                }
+                return 0;
+            },
+            job);
+        if (generation == 0)
+        {
+            throw std::runtime_error("--cards needs an event6 or event7 job");
+        }
+
+        std::vector<JobSearcher> jobs;
+        for (const auto &card : Wondercard::loadDirectory(settings.cards, generation))
+        {
+            if (!card.isValid())
+            {
+                std::cerr << "Skipping " << card.getName() << ": " << card.getError() << std::endl;
+                continue;
+            }
+
+            jobs.emplace_back(getJob(settings.jobs.front()));
+            std::visit(
+                [&card](auto &searcher) {
+                    using SearcherType = typename std::decay_t<decltype(searcher)>::element_type;
+                    if constexpr (std::is_same_v<SearcherType, EventSearcher6> || std::is_same_v<SearcherType, EventSearcher7>)
+                    {
+                        searcher->setWondercard(card);
+                    }
+                },
+                jobs.back());
+            tags.push_back({ { "card", card.getName() } });
+        }
+
+        if (jobs.empty())
+        {
+            throw std::runtime_error("No wondercards found in " + settings.cards);
+        }
+        return jobs;
+    }
+
+    // Runs every job in one pass per generation, jobs with the same profile and date range share seeds and RNG windows
+    void runBatch(std::vector<JobSearcher> &jobs, const std::vector<json> &tags, const Settings &settings, ResultWriter &writer)
+    {
+        BatchSearcher<u32, MT> batch6;
+        BatchSearcher<u64, SFMT> batch7;
+        for (size_t i = 0; i < jobs.size(); i++)
+        {
+            std::visit(
+                [&](auto &searcher) {
+                    using ResultType = typename decltype(searcher->getResults())::value_type;
+                    const json &tag = tags[i];
+                    searcher->setResultCallback([&writer, &tag](const std::vector<ResultType> &results) { writer.write(results, tag); });
+
+                    using SearcherType = typename std::decay_t<decltype(searcher)>::element_type;
+                    if constexpr (std::is_same_v<SearcherType, StationarySearcher6> || std::is_same_v<SearcherType, EventSearcher6>)
+                    {
+                        batch6.addJob(searcher.get());
+                    }
+                    else
+                    {
+                        batch7.addJob(searcher.get());
+                    }
+                },
+                jobs[i]);
+        }
+
+        std::cerr << jobs.size() << " jobs in " << batch6.getGroupCount() + batch7.getGroupCount() << " seed groups" << std::endl;
+
+        auto search = std::async(std::launch::async, [&] {
+            batch6.startSearch(settings.threads);
+            batch7.startSearch(settings.threads);
+        });
+        waitSearch(
+            search, settings,
+            [&] {
+                batch6.cancelSearch();
+                batch7.cancelSearch();
+            },
+            [&] {
+                u64 progress = batch6.getProgress() + batch7.getProgress();
+                u64 maxProgress = batch6.getMaxProgress() + batch7.getMaxProgress();
+                std::fprintf(stderr, "\r%.2f%% %llu results   ", maxProgress == 0 ? 100.0 : 100.0 * progress / maxProgress,
+                             static_cast<unsigned long long>(writer.getCount()));
+            });
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Settings settings;
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::cerr << "Usage: 3DSTimeFinderCLI <job.json | -> [job.json ...] [--cards directory] [--threads n] [--output file] [--csv] "
+                     "[--progress] [--trace file.json] [--journal file] [--first n] [--anchor date [--radius seconds]] "
+                     "[--histogram hours|days]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<JobSearcher> jobs;
+    std::vector<json> tags;
+    std::unique_ptr<SeedDateFinder7> finder;
+    try
+    {
+        if (settings.jobs.size() == 1 && settings.jobs.front() != "-")
+        {
+            finder = Job::loadSeedJob(settings.jobs.front());
+        }
+
+        if (finder)
+        {
+            std::string option = settings.cards.empty() ? getSingleJobOption(settings) : "--cards";
+            if (!option.empty())
+            {
+                throw std::runtime_error(option + " is not supported for seeds7 jobs");
+            }
+        }
+        else if (!settings.cards.empty())
+        {
+            jobs = getCardJobs(settings, tags);
+        }
+        else
+        {
+            for (size_t i = 0; i < settings.jobs.size(); i++)
+            {
+                jobs.emplace_back(getJob(settings.jobs[i]));
+                tags.push_back({ { "job", i } });
+            }
+        }
+
+        // Batches run every job through BatchSearcher, which has none of the single job options
+        std::string option = getSingleJobOption(settings);
+        if (!finder && (jobs.size() != 1 || !settings.cards.empty()) && !option.empty())
+        {
+            throw std::runtime_error(option + " is only supported for a single job");
+        }
+
+        if (!settings.anchor.empty())
+        {
+            DateTime anchor = Job::parseDateTime(settings.anchor);
+            for (auto &job : jobs)
+            {
+                std::visit([&](auto &searcher) { searcher->setAnchor(anchor, settings.radius); }, job);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!settings.output.empty())
+    {
+        file.open(settings.output);
+        if (!file.is_open())
+        {
+            std::cerr << "Unable to open " << settings.output << std::endl;
+            return 1;
+        }
+    }
+    ResultWriter writer(settings.output.empty() ? std::cout : file, settings.csv);
+
+    std::signal(SIGINT, [](int) { interrupted = 1; });
+
+    if (finder)
+    {
+        runSeedJob(*finder, settings, writer);
+    }
+    else if (jobs.size() == 1 && settings.cards.empty())
+    {
+        runJob(jobs.front(), settings, writer);
+    }
+    else
+    {
+        runBatch(jobs, tags, settings, writer);
+    }
+
+    std::cerr << writer.getCount() << " results" << (interrupted ? " before the search was cancelled" : "") << std::endl;
+    return interrupted ? 130 : 0;
+}
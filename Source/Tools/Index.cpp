@@ -0,0 +1,60 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <Tools/Job.hpp>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: 3DSTimeFinderIndex <job.json> <index directory> [threads]" << std::endl;
+        return 1;
+    }
+
+    int threads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+
+    JobSearcher job;
+    try
+    {
+        job = Job::loadJob(argv[1]);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return std::visit(
+        [&](auto &searcher) {
+            auto build = std::async(std::launch::async, [&] { return searcher->buildSeedIndex(argv[2], threads); });
+            while (build.wait_for(std::chrono::seconds(1)) != std::future_status::ready)
+            {
+                std::cout << "\r" << searcher->getProgress() * 100 / 65536 << "%" << std::flush;
+            }
+
+            bool built = build.get();
+            std::cout << "\r" << (built ? "Index built" : "Failed to build index") << std::endl;
+            return built ? 0 : 1;
+        },
+        job);
+}
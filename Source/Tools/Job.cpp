@@ -0,0 +1,345 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "Job.hpp"
+#include <Core/Util/IDType.hpp>
+#include <Core/Util/PIDType.hpp>
+#include <Core/Util/TimeMask.hpp>
+#include <Core/Util/WildType.hpp>
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace
+{
+    DateTime getDateTime(const json &j)
+    {
+        return Job::parseDateTime(j.get<std::string>());
+    }
+
+    std::vector<bool> getChecks(const json &j, const char *key, size_t size)
+    {
+        std::vector<bool> checks(size, true);
+        if (j.contains(key))
+        {
+            checks = j[key].get<std::vector<bool>>();
+            if (checks.size() != size)
+            {
+                throw std::runtime_error(std::string("Expected ") + std::to_string(size) + " entries for " + key);
+            }
+        }
+        return checks;
+    }
+
+    Profile6 getProfile6(const json &j)
+    {
+        std::string name = j.value("name", "");
+        u32 saveVariable = std::stoul(j["save"].get<std::string>(), nullptr, 16);
+        u32 timeVariable = std::stoul(j["time"].get<std::string>(), nullptr, 16);
+        Game version = j["version"].get<Game>();
+        u16 tid = j["tid"].get<u16>();
+        u16 sid = j["sid"].get<u16>();
+        bool shinyCharm = j.value("charm", false);
+        return Profile6(name, saveVariable, timeVariable, tid, sid, version, shinyCharm);
+    }
+
+    Profile7 getProfile7(const json &j)
+    {
+        std::string name = j.value("name", "");
+        u32 offset = j["offset"].get<u32>();
+        u32 tick = std::stoul(j["tick"].get<std::string>(), nullptr, 16);
+        u16 tid = j["tid"].get<u16>();
+        u16 sid = j["sid"].get<u16>();
+        Game version = j["version"].get<Game>();
+        bool shinyCharm = j.value("charm", false);
+        return Profile7(name, offset, tick, tid, sid, version, shinyCharm);
+    }
+
+    template <class Filter>
+    Filter getFilter(const json &j)
+    {
+        json filter = j.value("filter", json::object());
+        std::array<u8, 6> minIV = filter.value("minIVs", std::array<u8, 6> { 0, 0, 0, 0, 0, 0 });
+        std::array<u8, 6> maxIV = filter.value("maxIVs", std::array<u8, 6> { 31, 31, 31, 31, 31, 31 });
+        std::vector<bool> natures = getChecks(filter, "natures", 25);
+        std::vector<bool> hiddenPowers = getChecks(filter, "hiddenPowers", 16);
+        u8 ability = filter.value("ability", 255);
+        u8 shiny = filter.value("shiny", 255);
+        u8 gender = filter.value("gender", 255);
+
+        if constexpr (std::is_same_v<Filter, WildFilter>)
+        {
+            std::vector<bool> encounterSlots = getChecks(filter, "encounterSlots", 10);
+            return WildFilter(minIV, maxIV, natures, hiddenPowers, encounterSlots, ability, shiny, gender);
+        }
+        else
+        {
+            return Filter(minIV, maxIV, natures, hiddenPowers, ability, shiny, gender);
+        }
+    }
+
+    // Weekdays start at Sunday, times are times of day like "18:00-23:00" and intervals are [start, end] date pairs
+    TimeMask getTimeMask(const json &j)
+    {
+        TimeMask mask;
+        if (j.contains("weekdays"))
+        {
+            mask.setWeekdays(getChecks(j, "weekdays", 7));
+        }
+        if (j.contains("times") && !mask.addTimes(j["times"].get<std::string>()))
+        {
+            throw std::runtime_error("Invalid times " + j["times"].get<std::string>());
+        }
+        for (const auto &interval : j.value("intervals", json::array()))
+        {
+            mask.addInterval(getDateTime(interval.at(0)), getDateTime(interval.at(1)));
+        }
+        return mask;
+    }
+
+    StationaryTarget getStationaryTarget(const json &j)
+    {
+        return StationaryTarget(j.value("ivCount", 0) == 3, j.value("ability", 255), j.value("synchNature", 0), j.value("genderRatio", 255),
+                                j.value("alwaysSynch", false), j.value("shinyLocked", false), getFilter<StationaryFilter>(j));
+    }
+
+    // A targets array searches every entry in one pass, each entry has the same keys a single target job has
+    template <class Searcher, class Profile>
+    std::unique_ptr<Searcher> getStationary(const json &j, const DateTime &start, const DateTime &end, u32 startFrame, u32 endFrame,
+                                            const Profile &profile)
+    {
+        std::vector<StationaryTarget> targets;
+        if (j.contains("targets"))
+        {
+            for (const auto &target : j["targets"])
+            {
+                targets.emplace_back(getStationaryTarget(target));
+            }
+            if (targets.empty())
+            {
+                throw std::runtime_error("Expected at least one target");
+            }
+        }
+        else
+        {
+            targets.emplace_back(getStationaryTarget(j));
+        }
+        return std::make_unique<Searcher>(start, end, startFrame, endFrame, targets, profile);
+    }
+
+    template <class Searcher, class Profile>
+    std::unique_ptr<Searcher> getEvent(const json &j, const DateTime &start, const DateTime &end, u32 startFrame, u32 endFrame,
+                                       const Profile &profile)
+    {
+        auto searcher = std::make_unique<Searcher>(start, end, startFrame, endFrame, j.value("ivCount", 0),
+                                                   static_cast<PIDType>(j.value("pidType", 0)), profile, getFilter<EventFilter>(j));
+
+        json locks = j.value("locks", json::object());
+        searcher->setLocks(locks.contains("ability"), locks.value("ability", 0), locks.contains("nature"), locks.value("nature", 0),
+                           locks.contains("gender"), locks.value("gender", 0));
+        searcher->setIDs(j.contains("tid"), j.value("tid", 0), j.value("sid", 0), j.value("ownID", false));
+        searcher->setHidden(std::stoul(j.value("pid", "0"), nullptr, 16), std::stoul(j.value("ec", "0"), nullptr, 16));
+        searcher->setIVTemplate(j.value("ivTemplate", std::array<u8, 6> { 255, 255, 255, 255, 255, 255 }));
+
+        // A wondercard file replaces the card related keys above
+        if (j.contains("wondercard"))
+        {
+            Wondercard card(j["wondercard"].get<std::string>());
+            if (!card.isValid())
+            {
+                throw std::runtime_error(card.getName() + ": " + card.getError());
+            }
+            searcher->setWondercard(card);
+        }
+        return searcher;
+    }
+
+    JobSearcher getSearcher(const json &j)
+    {
+        std::string type = j["type"].get<std::string>();
+        DateTime start = getDateTime(j["start"]);
+        DateTime end = getDateTime(j["end"]);
+        u32 startFrame = j.value("startFrame", 0);
+        u32 endFrame = j["endFrame"].get<u32>();
+        if (start > end || startFrame > endFrame)
+        {
+            throw std::runtime_error("Start must not be after end");
+        }
+
+        if (type == "stationary6")
+        {
+            return getStationary<StationarySearcher6>(j, start, end, startFrame, endFrame, getProfile6(j["profile"]));
+        }
+        else if (type == "event6")
+        {
+            return getEvent<EventSearcher6>(j, start, end, startFrame, endFrame, getProfile6(j["profile"]));
+        }
+        else if (type == "stationary7")
+        {
+            return getStationary<StationarySearcher7>(j, start, end, startFrame, endFrame, getProfile7(j["profile"]));
+        }
+        else if (type == "wild7")
+        {
+            return std::make_unique<WildSearcher7>(start, end, startFrame, endFrame, j.value("useSynch", false),
+                                                   j.value("synchNature", 0), static_cast<WildType>(j.value("wildType", 0)),
+                                                   j.value("genderRatio", 255), getProfile7(j["profile"]), getFilter<WildFilter>(j));
+        }
+        else if (type == "event7")
+        {
+            return getEvent<EventSearcher7>(j, start, end, startFrame, endFrame, getProfile7(j["profile"]));
+        }
+        else if (type == "id7")
+        {
+            IDFilter filter(j.value("ids", ""), j.value("tsvs", ""), static_cast<IDType>(j.value("idType", 0)));
+            auto searcher = std::make_unique<IDSearcher7>(start, end, startFrame, endFrame, getProfile7(j["profile"]), filter);
+
+            std::vector<u32> pids;
+            for (const auto &pid : j.value("pids", std::vector<std::string>()))
+            {
+                pids.emplace_back(std::stoul(pid, nullptr, 16));
+            }
+            searcher->setTargetPIDs(pids);
+            return searcher;
+        }
+
+        else if (type == "seeds7")
+        {
+            throw std::runtime_error("A seeds7 job has to be run on its own");
+        }
+
+        throw std::runtime_error("Unknown job type " + type);
+    }
+
+    // Seeds are hex strings like the rest of the job
+    std::unique_ptr<SeedDateFinder7> getSeedFinder(const json &j)
+    {
+        DateTime start = getDateTime(j["start"]);
+        DateTime end = getDateTime(j["end"]);
+        if (start > end)
+        {
+            throw std::runtime_error("Start must not be after end");
+        }
+
+        std::vector<u32> seeds;
+        for (const auto &seed : j["seeds"].get<std::vector<std::string>>())
+        {
+            seeds.emplace_back(std::stoul(seed, nullptr, 16));
+        }
+        if (seeds.empty())
+        {
+            throw std::runtime_error("Expected at least one seed");
+        }
+        return std::make_unique<SeedDateFinder7>(start, end, getProfile7(j["profile"]), seeds);
+    }
+}
+
+namespace Job
+{
+    DateTime parseDateTime(const std::string &text)
+    {
+        int year, month, day, hour = 0, minute = 0, second = 0;
+        if (std::sscanf(text.c_str(), "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second) < 3 || year < 2000
+            || year > 2099)
+        {
+            throw std::runtime_error("Invalid date " + text);
+        }
+        return DateTime(year, month, day, hour, minute, second);
+    }
+
+    JobSearcher loadJob(const std::string &path)
+    {
+        std::ifstream read(path);
+        if (!read.is_open())
+        {
+            throw std::runtime_error("Unable to open " + path);
+        }
+        return readJob(read, path);
+    }
+
+    JobSearcher readJob(std::istream &stream, const std::string &name)
+    {
+        json j = json::parse(stream, nullptr, false);
+        if (j.is_discarded())
+        {
+            throw std::runtime_error("Unable to parse " + name);
+        }
+
+        try
+        {
+            JobSearcher searcher = getSearcher(j);
+
+            // Same limit the forms use, larger deltas search other seconds and can wrap the epoch around
+            std::vector<int> offsetDeltas = j.value("offsetDeltas", std::vector<int> { 0 });
+            for (int delta : offsetDeltas)
+            {
+                if (delta < -1000 || delta > 1000)
+                {
+                    throw std::runtime_error(name + ": offset delta " + std::to_string(delta) + " is outside of -1000 to 1000 ms");
+                }
+            }
+            TimeMask mask = getTimeMask(j);
+            std::visit(
+                [&](auto &job) {
+                    job->setOffsetDeltas(offsetDeltas);
+                    job->setTimeMask(mask);
+                },
+                searcher);
+            return searcher;
+        }
+        catch (const json::exception &e)
+        {
+            throw std::runtime_error(std::string("Invalid job: ") + e.what());
+        }
+        catch (const std::logic_error &e)
+        {
+            throw std::runtime_error(std::string("Invalid job: ") + e.what());
+        }
+    }
+
+    std::unique_ptr<SeedDateFinder7> loadSeedJob(const std::string &path)
+    {
+        std::ifstream read(path);
+        if (!read.is_open())
+        {
+            throw std::runtime_error("Unable to open " + path);
+        }
+
+        json j = json::parse(read, nullptr, false);
+        if (j.is_discarded())
+        {
+            throw std::runtime_error("Unable to parse " + path);
+        }
+
+        try
+        {
+            return j.value("type", "") == "seeds7" ? getSeedFinder(j) : nullptr;
+        }
+        catch (const json::exception &e)
+        {
+            throw std::runtime_error(std::string("Invalid job: ") + e.what());
+        }
+        catch (const std::logic_error &e)
+        {
+            throw std::runtime_error(std::string("Invalid job: ") + e.what());
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef JOB_HPP
+#define JOB_HPP
+
+#include <Core/Gen6/EventSearcher6.hpp>
+#include <Core/Gen6/StationarySearcher6.hpp>
+#include <Core/Gen7/EventSearcher7.hpp>
+#include <Core/Gen7/IDSearcher7.hpp>
+#include <Core/Gen7/SeedDateFinder7.hpp>
+#include <Core/Gen7/StationarySearcher7.hpp>
+#include <Core/Gen7/WildSearcher7.hpp>
+#include <istream>
+#include <memory>
+#include <string>
+#include <variant>
+
+using JobSearcher = std::variant<std::unique_ptr<StationarySearcher6>, std::unique_ptr<EventSearcher6>, std::unique_ptr<StationarySearcher7>,
+                                 std::unique_ptr<WildSearcher7>, std::unique_ptr<EventSearcher7>, std::unique_ptr<IDSearcher7>>;
+
+namespace Job
+{
+    // Creates the searcher described by a JSON job file, the profile object uses the same keys as profiles.json.
+    // Throws std::runtime_error if the file can not be read or the job is invalid.
+    JobSearcher loadJob(const std::string &path);
+
+    // Same as loadJob() for a job read from a stream such as stdin
+    JobSearcher readJob(std::istream &stream, const std::string &name);
+
+    // Creates the finder of a seeds7 job, which lists seeds to find the dates of instead of frames to search for.
+    // Returns nullptr for any other job type, throws std::runtime_error if the file can not be read or the job is invalid.
+    std::unique_ptr<SeedDateFinder7> loadSeedJob(const std::string &path);
+
+    // Reads a "YYYY-MM-DD[ HH:MM:SS]" date as used by job files, throws std::runtime_error if it is invalid
+    DateTime parseDateTime(const std::string &text);
+}
+
+#endif // JOB_HPP
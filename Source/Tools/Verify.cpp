@@ -0,0 +1,1472 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "Verify.hpp"
+#include <Core/Gen6/EventSearcher6.hpp>
+#include <Core/Gen6/StationarySearcher6.hpp>
+#include <Core/Gen7/EventSearcher7.hpp>
+#include <Core/Gen7/IDSearcher7.hpp>
+#include <Core/Gen7/SeedDateFinder7.hpp>
+#include <Core/Gen7/StationarySearcher7.hpp>
+#include <Core/Gen7/WildSearcher7.hpp>
+#include <Core/Parents/BatchSearcher.hpp>
+#include <Core/Parents/ResultCache.hpp>
+#include <Core/Parents/SearchCoverage.hpp>
+#include <Core/Parents/SearchHistogram.hpp>
+#include <Core/RNG/MT.hpp>
+#include <Core/RNG/RNGList.hpp>
+#include <Core/RNG/Reference.hpp>
+#include <Core/RNG/SFMT.hpp>
+#include <Core/Util/Game.hpp>
+#include <Core/Util/IDType.hpp>
+#include <Core/Util/PIDType.hpp>
+#include <Core/Util/TimeMask.hpp>
+#include <Core/Util/Utility.hpp>
+#include <Core/Util/WildType.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+
+namespace
+{
+    constexpr u32 maximumFrameOffset = 5000;
+    constexpr u32 compareCount = 2000;
+
+    const char *getISA()
+    {
+#if defined(__i386__) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_AMD64)
+        return "SSE4.1";
+#elif defined(__arm__) || defined(_M_ARM) || defined(__aarch64__)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    bool report(const std::string &name, int mismatches, int checks)
+    {
+        std::cerr << (mismatches == 0 ? "ok       " : "MISMATCH ") << name << " " << checks - mismatches << "/" << checks << std::endl;
+        return mismatches == 0;
+    }
+
+    // Jumping ahead, RNGList and plain next() of SFMT have to produce the reference output from any starting frame
+    bool verifySFMT(std::mt19937 &random, int iterations)
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; i++)
+        {
+            u32 seed = random();
+            u32 frames = random() % maximumFrameOffset;
+
+            Reference::SFMT reference(seed);
+            for (u32 frame = 0; frame < frames; frame++)
+            {
+                reference.next();
+            }
+
+            SFMT sfmt(seed, frames);
+            SFMT listRNG(seed, frames);
+            RNGList<u64, SFMT, 64> rngList(listRNG);
+
+            bool match = true;
+            for (u32 j = 0; j < compareCount; j++, rngList.advanceState())
+            {
+                u64 expected = reference.next();
+                match &= sfmt.next() == expected;
+                match &= rngList.getValue() == expected;
+            }
+            if (!match)
+            {
+                std::fprintf(stderr, "  sfmt seed %08x frames %u\n", seed, frames);
+                mismatches++;
+            }
+        }
+        return report("sfmt", mismatches, iterations);
+    }
+
+    bool verifyMT(std::mt19937 &random, int iterations)
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; i++)
+        {
+            u32 seed = random();
+            u32 frames = random() % maximumFrameOffset;
+
+            Reference::MT reference(seed);
+            for (u32 frame = 0; frame < frames; frame++)
+            {
+                reference.next();
+            }
+
+            MT mt(seed, frames);
+            MT listRNG(seed, frames);
+            RNGList<u32, MT, 128> rngList(listRNG);
+
+            bool match = true;
+            for (u32 j = 0; j < compareCount; j++, rngList.advanceState())
+            {
+                u32 expected = reference.next();
+                match &= mt.next() == expected;
+                match &= rngList.getValue() == expected;
+            }
+            if (!match)
+            {
+                std::fprintf(stderr, "  mt seed %08x frames %u\n", seed, frames);
+                mismatches++;
+            }
+        }
+        return report("mt", mismatches, iterations);
+    }
+
+    // Batches of random length so every SIMD lane position and the scalar tail get checked
+    bool verifyHash(std::mt19937 &random, int iterations)
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; i++)
+        {
+            u32 tick = random();
+            u32 count = 1 + random() % 67;
+
+            std::vector<u64> epochs(count);
+            for (auto &epoch : epochs)
+            {
+                epoch = ((static_cast<u64>(random()) << 32) | random()) & 0x3ffffffffffull;
+            }
+
+            std::vector<u32> seeds(count);
+            Utility::calcInitialSeeds(tick, epochs.data(), count, seeds.data());
+
+            bool match = true;
+            for (u32 j = 0; j < count; j++)
+            {
+                u32 expected = Reference::calcInitialSeed(tick, epochs[j]);
+                match &= Utility::calcInitialSeed(tick, epochs[j]) == expected;
+                match &= seeds[j] == expected;
+            }
+            if (!match)
+            {
+                std::fprintf(stderr, "  hash tick %08x count %u\n", tick, count);
+                mismatches++;
+            }
+        }
+        return report("sha256", mismatches, iterations);
+    }
+
+    // RNGList over a reference RNG. Each frame reads its values from the start of the list, values are generated as a frame
+    // asks for them and advanceState() drops the first.
+    template <class RNG>
+    class ReferenceList
+    {
+    public:
+        using IntegerType = decltype(std::declval<RNG &>().next());
+
+        ReferenceList(u32 seed, u32 frames) : rng(seed), pointer(0)
+        {
+            for (u32 frame = 0; frame < frames; frame++)
+            {
+                rng.next();
+            }
+        }
+
+        void advanceState()
+        {
+            if (values.empty())
+            {
+                rng.next();
+            }
+            else
+            {
+                values.pop_front();
+            }
+            pointer = 0;
+        }
+
+        void advanceFrames(u32 frames)
+        {
+            pointer += frames;
+        }
+
+        IntegerType getValue()
+        {
+            while (values.size() <= pointer)
+            {
+                values.push_back(rng.next());
+            }
+            return values[pointer++];
+        }
+
+    private:
+        RNG rng;
+        std::deque<IntegerType> values;
+        size_t pointer;
+    };
+
+    // Generates one frame from the list and appends it to hits when it passes the filter
+    template <class RNG, class ResultType>
+    using ReferenceKernel = std::function<void(u32 initialSeed, u32 frame, ReferenceList<RNG> &rngList, std::vector<ResultType> &hits)>;
+
+    // Searcher that hashes its seeds one at a time and generates every frame with a reference RNG and a kernel written
+    // here, so it shares neither the seed batches, the RNG windows nor the kernels of the searcher it is compared to
+    template <class Base, class RNG, class ResultType>
+    class ReferenceSearcher : public Base
+    {
+    public:
+        template <typename... Args>
+        ReferenceSearcher(const std::function<u32(u64)> &seed, const ReferenceKernel<RNG, ResultType> &kernel, Args &&...args) :
+            Base(std::forward<Args>(args)...), seed(seed), kernel(kernel)
+        {
+        }
+
+    private:
+        std::function<u32(u64)> seed;
+        ReferenceKernel<RNG, ResultType> kernel;
+
+        u32 getInitialSeed(u64 epoch) const override
+        {
+            return seed(epoch);
+        }
+
+        void getInitialSeeds(const u64 *epochs, u32 count, u32 *seeds) const override
+        {
+            for (u32 i = 0; i < count; i++)
+            {
+                seeds[i] = seed(epochs[i]);
+            }
+        }
+
+        void searchSeed(u32 initialSeed, u32 frameStart, u32 frameEnd, const ResultFilter *, std::vector<ResultType> &hits) override
+        {
+            ReferenceList<RNG> rngList(initialSeed, frameStart);
+            for (u32 frame = frameStart; frame <= frameEnd; frame++, rngList.advanceState())
+            {
+                kernel(initialSeed, frame, rngList, hits);
+            }
+        }
+    };
+
+    // Everything the forms set on an event searcher
+    struct EventSettings
+    {
+        u8 ivCount;
+        PIDType pidType;
+        bool abilityLocked, natureLocked, genderLocked, otherInfo, ownID;
+        u8 ability, nature, gender;
+        u16 tid, sid;
+        u32 pid, ec;
+        std::array<u8, 6> ivTemplate;
+    };
+
+    template <class Searcher>
+    void setupEvent(Searcher &searcher, const EventSettings &settings)
+    {
+        searcher.setLocks(settings.abilityLocked, settings.ability, settings.natureLocked, settings.nature, settings.genderLocked,
+                          settings.gender);
+        searcher.setIDs(settings.otherInfo, settings.tid, settings.sid, settings.ownID);
+        searcher.setHidden(settings.pid, settings.ec);
+        searcher.setIVTemplate(settings.ivTemplate);
+    }
+
+    ReferenceKernel<Reference::MT, StationaryResult> getStationaryKernel6(const Profile6 &profile, const StationaryTarget &target)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::MT> &rngList, std::vector<StationaryResult> &hits) {
+            StationaryResult result(initialSeed, profile.getTID(), profile.getSID());
+
+            if (!target.alwaysSynch)
+            {
+                rngList.advanceFrames(60);
+            }
+
+            result.setEC(rngList.getValue());
+
+            for (u8 i = 0; i < (profile.getShinyCharm() ? 3 : 1); i++)
+            {
+                result.setPID(rngList.getValue());
+                if (result.getShiny())
+                {
+                    if (target.shinyLocked)
+                    {
+                        result.setPID(result.getPID() ^ 0x10000000);
+                    }
+                    break;
+                }
+            }
+
+            for (u8 i = 0; i < target.ivCount;)
+            {
+                u8 tmp = static_cast<u64>(rngList.getValue()) * 6 >> 32;
+                if (result.getIV(tmp) == 255)
+                {
+                    result.setIV(tmp, 31);
+                    i++;
+                }
+            }
+
+            for (u8 i = 0; i < 6; i++)
+            {
+                if (result.getIV(i) == 255)
+                {
+                    result.setIV(i, rngList.getValue() >> 27);
+                }
+            }
+            result.calcHiddenPower();
+
+            result.setAbility(target.ability != 255 ? target.ability : rngList.getValue() >> 31);
+
+            result.setNature(target.alwaysSynch ? target.synchNature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
+
+            result.setGender((target.gender > 0 && target.gender < 254) ? (static_cast<u64>(rngList.getValue()) * 252 >> 32 < target.gender)
+                                                                        : target.gender);
+
+            if (target.filter.compare(result))
+            {
+                result.setFrame(frame);
+                result.setEncounter(0);
+                hits.emplace_back(result);
+            }
+        };
+    }
+
+    ReferenceKernel<Reference::MT, EventResult> getEventKernel6(const Profile6 &profile, const EventSettings &settings,
+                                                                const EventFilter &filter)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::MT> &rngList, std::vector<EventResult> &hits) {
+            EventResult result(initialSeed, settings.ownID ? profile.getTID() : settings.tid,
+                               settings.ownID ? profile.getSID() : settings.sid);
+
+            for (u8 j = 0; j < ((profile.getVersion() & Game::ORAS) ? 2 : 1); j++)
+            {
+                result.setEC(settings.ec > 0 ? settings.ec : rngList.getValue());
+
+                switch (settings.pidType)
+                {
+                case PIDType::Random:
+                    result.setPID(rngList.getValue());
+                    break;
+                case PIDType::Nonshiny:
+                    result.setPID(rngList.getValue());
+                    if (result.getShiny())
+                    {
+                        result.setPID(result.getPID() ^ 0x10000000);
+                    }
+                    break;
+                case PIDType::Shiny:
+                    result.setPID(rngList.getValue());
+                    if (settings.otherInfo)
+                    {
+                        result.setPID(((settings.tid ^ settings.sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
+                    }
+                    break;
+                case PIDType::Specified:
+                    result.setPID(settings.pid);
+                    break;
+                }
+
+                result.setIVs(settings.ivTemplate);
+                for (u8 i = 0; i < settings.ivCount;)
+                {
+                    u8 tmp = static_cast<u64>(rngList.getValue()) * 6 >> 32;
+                    if (result.getIV(tmp) == 255)
+                    {
+                        result.setIV(tmp, 31);
+                        i++;
+                    }
+                }
+
+                for (u8 i = 0; i < 6; i++)
+                {
+                    if (result.getIV(i) == 255)
+                    {
+                        result.setIV(i, rngList.getValue() >> 27);
+                    }
+                }
+                result.calcHiddenPower();
+
+                result.setAbility(settings.abilityLocked ? settings.ability
+                                                         : (static_cast<u64>(rngList.getValue()) * (settings.ability + 2) >> 32));
+
+                result.setNature(settings.natureLocked ? settings.nature : static_cast<u64>(rngList.getValue()) * 25 >> 32);
+
+                result.setGender(settings.genderLocked ? settings.gender
+                                                       : (static_cast<u64>(rngList.getValue()) * 252 >> 32) < settings.gender);
+            }
+
+            if (filter.compare(result))
+            {
+                result.setFrame(frame);
+                hits.emplace_back(result);
+            }
+        };
+    }
+
+    ReferenceKernel<Reference::SFMT, StationaryResult> getStationaryKernel7(const Profile7 &profile, const StationaryTarget &target)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::SFMT> &rngList, std::vector<StationaryResult> &hits) {
+            StationaryResult result(initialSeed, profile.getTID(), profile.getSID());
+
+            result.setEC(rngList.getValue() & 0xffffffff);
+
+            for (u8 i = 0; i < (profile.getShinyCharm() ? 3 : 1); i++)
+            {
+                result.setPID(rngList.getValue() & 0xffffffff);
+                if (result.getShiny())
+                {
+                    if (target.shinyLocked)
+                    {
+                        result.setPID(result.getPID() ^ 0x10000000);
+                    }
+                    break;
+                }
+            }
+
+            for (u8 i = 0; i < target.ivCount;)
+            {
+                u8 tmp = rngList.getValue() % 6;
+                if (result.getIV(tmp) == 255)
+                {
+                    result.setIV(tmp, 31);
+                    i++;
+                }
+            }
+
+            for (u8 i = 0; i < 6; i++)
+            {
+                if (result.getIV(i) == 255)
+                {
+                    result.setIV(i, rngList.getValue() & 0x1f);
+                }
+            }
+            result.calcHiddenPower();
+
+            result.setAbility(target.ability != 255 ? target.ability : rngList.getValue() & 1);
+
+            result.setNature(target.alwaysSynch ? target.synchNature : rngList.getValue() % 25);
+
+            result.setGender((target.gender > 0 && target.gender < 254) ? (rngList.getValue() % 252 < target.gender) : target.gender);
+
+            if (target.filter.compare(result))
+            {
+                result.setFrame(frame);
+                result.setEncounter(0);
+                hits.emplace_back(result);
+            }
+        };
+    }
+
+    u8 getWildSlot(WildType type, u8 value)
+    {
+        constexpr u8 grassSlots[10] = { 19, 39, 49, 59, 69, 79, 89, 94, 98, 99 };
+        constexpr u8 waterSlots[3] = { 78, 98, 99 };
+
+        const u8 *slots = type == WildType::Grass ? grassSlots : waterSlots;
+        u8 count = type == WildType::Grass ? 10 : 3;
+        for (u8 i = 0; i < count; i++)
+        {
+            if (value <= slots[i])
+            {
+                return i + 1;
+            }
+        }
+        return 255;
+    }
+
+    ReferenceKernel<Reference::SFMT, WildResult> getWildKernel7(const Profile7 &profile, bool useSynch, u8 synchNature, WildType type,
+                                                                u8 gender, const WildFilter &filter)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::SFMT> &rngList, std::vector<WildResult> &hits) {
+            WildResult result(initialSeed, profile.getTID(), profile.getSID());
+
+            bool synch = (rngList.getValue() % 100 >= 50) && useSynch;
+
+            result.setEncounterSlot(getWildSlot(type, rngList.getValue() % 100));
+
+            // Level, flute and the 60 frame delay
+            rngList.advanceFrames(62);
+
+            result.setEC(rngList.getValue() & 0xffffffff);
+
+            for (u8 i = 0; i < (profile.getShinyCharm() ? 3 : 1); i++)
+            {
+                result.setPID(rngList.getValue() & 0xffffffff);
+                if (result.getShiny())
+                {
+                    break;
+                }
+            }
+
+            for (u8 i = 0; i < 6; i++)
+            {
+                result.setIV(i, rngList.getValue() & 0x1f);
+            }
+            result.calcHiddenPower();
+
+            result.setAbility(rngList.getValue() & 1);
+
+            result.setNature(synch ? synchNature : rngList.getValue() % 25);
+
+            result.setGender((gender > 0 && gender < 254) ? (rngList.getValue() % 252 >= gender ? 1 : 2) : gender);
+
+            if (filter.compare(result))
+            {
+                result.setFrame(frame);
+                hits.emplace_back(result);
+            }
+        };
+    }
+
+    ReferenceKernel<Reference::SFMT, EventResult> getEventKernel7(const Profile7 &profile, const EventSettings &settings,
+                                                                  const EventFilter &filter)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::SFMT> &rngList, std::vector<EventResult> &hits) {
+            EventResult result(initialSeed, settings.ownID ? profile.getTID() : settings.tid,
+                               settings.ownID ? profile.getSID() : settings.sid);
+
+            result.setEC(settings.ec > 0 ? settings.ec : rngList.getValue() & 0xffffffff);
+
+            switch (settings.pidType)
+            {
+            case PIDType::Random:
+                result.setPID(rngList.getValue() & 0xffffffff);
+                break;
+            case PIDType::Nonshiny:
+                result.setPID(rngList.getValue() & 0xffffffff);
+                if (result.getShiny())
+                {
+                    result.setPID(result.getPID() ^ 0x10000000);
+                }
+                break;
+            case PIDType::Shiny:
+                result.setPID(rngList.getValue() & 0xffffffff);
+                if (settings.otherInfo)
+                {
+                    result.setPID(((settings.tid ^ settings.sid ^ (result.getPID() & 0xFFFF)) << 16) | (result.getPID() & 0xFFFF));
+                }
+                break;
+            case PIDType::Specified:
+                result.setPID(settings.pid);
+                break;
+            }
+
+            result.setIVs(settings.ivTemplate);
+            for (u8 i = 0; i < settings.ivCount;)
+            {
+                u8 tmp = rngList.getValue() % 6;
+                if (result.getIV(tmp) == 255)
+                {
+                    result.setIV(tmp, 31);
+                    i++;
+                }
+            }
+
+            for (u8 i = 0; i < 6; i++)
+            {
+                if (result.getIV(i) == 255)
+                {
+                    result.setIV(i, rngList.getValue() & 0x1f);
+                }
+            }
+            result.calcHiddenPower();
+
+            if (settings.abilityLocked)
+            {
+                result.setAbility(settings.ability);
+            }
+            else
+            {
+                result.setAbility(settings.ability == 0 ? rngList.getValue() & 1 : rngList.getValue() % 3);
+            }
+
+            result.setNature(settings.natureLocked ? settings.nature : rngList.getValue() % 25);
+
+            result.setGender(settings.genderLocked ? settings.gender : (rngList.getValue() % 252) < settings.gender);
+
+            if (filter.compare(result))
+            {
+                result.setFrame(frame);
+                hits.emplace_back(result);
+            }
+        };
+    }
+
+    ReferenceKernel<Reference::SFMT, IDResult> getIDKernel7(const IDFilter &filter)
+    {
+        return [=](u32 initialSeed, u32 frame, ReferenceList<Reference::SFMT> &rngList, std::vector<IDResult> &hits) {
+            IDResult id(initialSeed, frame, rngList.getValue() & 0xffffffff);
+            if (filter.compare(id))
+            {
+                hits.emplace_back(id);
+            }
+        };
+    }
+
+    template <class ResultType>
+    std::string describe(const ResultType &result)
+    {
+        char line[256];
+        if constexpr (std::is_same_v<ResultType, IDResult>)
+        {
+            std::snprintf(line, sizeof(line), "%s %d %08x %u %u %u %u", result.getDateTime().c_str(), result.getOffsetDelta(),
+                          result.getSeed(), result.getFrame(), result.getTID(), result.getSID(), result.getDisplayTID());
+        }
+        else
+        {
+            std::snprintf(line, sizeof(line), "%s %d %08x %u %08x %08x %u %u %u %u %u %u %u %u %u %u", result.getDateTime().c_str(),
+                          result.getOffsetDelta(), result.getSeed(), result.getFrame(), result.getPID(), result.getEC(), result.getIV(0),
+                          result.getIV(1), result.getIV(2), result.getIV(3), result.getIV(4), result.getIV(5), result.getNature(),
+                          result.getAbility(), result.getGender(), result.getShiny());
+        }
+        return line;
+    }
+
+    // Sorted unless the order of the results is what's being checked
+    template <class ResultType>
+    std::vector<std::string> describe(const std::vector<ResultType> &results, bool sorted = true)
+    {
+        std::vector<std::string> lines;
+        for (const auto &result : results)
+        {
+            lines.emplace_back(describe(result));
+        }
+        if (sorted)
+        {
+            std::sort(lines.begin(), lines.end());
+        }
+        return lines;
+    }
+
+    std::vector<std::string> describe(const SearchHistogram &histogram)
+    {
+        std::vector<std::string> lines;
+        for (const auto &[hour, bucket] : histogram.getHours())
+        {
+            char line[128];
+            std::snprintf(line, sizeof(line), "%llu %llu %u %08x %d %llu", static_cast<unsigned long long>(hour),
+                          static_cast<unsigned long long>(bucket.hits), bucket.bestFrame, bucket.bestSeed, bucket.bestDelta,
+                          static_cast<unsigned long long>(bucket.bestTime));
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+
+    // The reference run uses one thread, so no tiles or frame slices, and unbatched reference seeds
+    template <class Searcher, class ReferenceType>
+    bool compareSearch(const std::string &name, Searcher &searcher, ReferenceType &reference, int threads)
+    {
+        searcher.startSearch(threads);
+        reference.startSearch(1);
+
+        auto results = describe(searcher.getResults());
+        auto expected = describe(reference.getResults());
+        if (results != expected)
+        {
+            std::cerr << "  " << name << " found " << results.size() << " results, expected " << expected.size() << std::endl;
+        }
+        return report(name + " (" + std::to_string(expected.size()) + " results)", results == expected ? 0 : 1, 1);
+    }
+
+    template <class Filter>
+    Filter getFilter(u8 minIV)
+    {
+        std::array<u8, 6> min = { minIV, minIV, minIV, 0, 0, 0 };
+        std::array<u8, 6> max = { 31, 31, 31, 31, 31, 31 };
+        std::vector<bool> natures(25, true);
+        std::vector<bool> hiddenPowers(16, true);
+
+        if constexpr (std::is_same_v<Filter, WildFilter>)
+        {
+            return WildFilter(min, max, natures, hiddenPowers, std::vector<bool>(10, true), 255, 255, 255);
+        }
+        else
+        {
+            return Filter(min, max, natures, hiddenPowers, 255, 255, 255);
+        }
+    }
+
+    // A long range with few frames and a short range with many frames, the latter gets split into frame slices. Each
+    // searcher is compared to a reference searcher with the reference RNGs, the reference hash and a kernel written here.
+    bool verifySearchers(std::mt19937 &random, int threads)
+    {
+        struct Range
+        {
+            DateTime start, end;
+            u32 endFrame;
+        };
+
+        u32 tick = random();
+        u32 offset = random() % 100;
+        Game version6 = random() % 2 == 0 ? Game::X : Game::OR;
+        Profile6 profile6("Verify", random(), random(), random() & 0xffff, random() & 0xffff, version6, false);
+        Profile7 profile7("Verify", offset, tick, random() & 0xffff, random() & 0xffff, Game::UltraSun, true);
+        std::vector<int> deltas = { -1, 0, 2 };
+
+        auto seed6 = [&profile6](u64 epoch) { return static_cast<u32>(profile6.getSaveVariable() + profile6.getTimeVariable() + epoch); };
+        auto seed7 = [tick](u64 epoch) { return Reference::calcInitialSeed(tick, epoch); };
+
+        // Options that change how many values a frame reads are picked at random
+        bool alwaysSynch = random() % 2 == 0;
+        bool shinyLocked = random() % 2 == 0;
+        u8 synchNature = random() % 25;
+        StationaryTarget target(false, 255, synchNature, 127, alwaysSynch, shinyLocked, getFilter<StationaryFilter>(30));
+
+        WildType type = random() % 2 == 0 ? WildType::Grass : WildType::Fish;
+
+        EventSettings event;
+        event.ivCount = random() % 4;
+        event.pidType = static_cast<PIDType>(random() % 4);
+        event.abilityLocked = random() % 2 == 0;
+        event.ability = random() % 3;
+        event.natureLocked = random() % 2 == 0;
+        event.nature = random() % 25;
+        event.genderLocked = random() % 2 == 0;
+        event.gender = 127;
+        event.otherInfo = true;
+        event.ownID = random() % 2 == 0;
+        event.tid = random() & 0xffff;
+        event.sid = random() & 0xffff;
+        event.pid = random();
+        event.ec = random() % 2 == 0 ? random() : 0;
+        event.ivTemplate = { 255, 255, 255, 255, 255, 255 };
+
+        bool match = true;
+        for (const auto &range : { Range { DateTime(2021, 3, 4, 5, 0, 0), DateTime(2021, 3, 4, 5, 19, 59), 1500 },
+                                   Range { DateTime(2021, 3, 4, 5, 0, 0), DateTime(2021, 3, 4, 5, 0, 1), 200000 } })
+        {
+            {
+                StationarySearcher6 searcher(range.start, range.end, 0, range.endFrame, { target }, profile6);
+                ReferenceSearcher<StationarySearcher6, Reference::MT, StationaryResult> reference(
+                    seed6, getStationaryKernel6(profile6, target), range.start, range.end, 0, range.endFrame,
+                    std::vector<StationaryTarget> { target }, profile6);
+                match &= compareSearch("stationary6", searcher, reference, threads);
+            }
+            {
+                EventSearcher6 searcher(range.start, range.end, 0, range.endFrame, event.ivCount, event.pidType, profile6,
+                                        getFilter<EventFilter>(30));
+                ReferenceSearcher<EventSearcher6, Reference::MT, EventResult> reference(
+                    seed6, getEventKernel6(profile6, event, getFilter<EventFilter>(30)), range.start, range.end, 0, range.endFrame,
+                    event.ivCount, event.pidType, profile6, getFilter<EventFilter>(30));
+                setupEvent(searcher, event);
+                setupEvent(reference, event);
+                match &= compareSearch("event6", searcher, reference, threads);
+            }
+            {
+                StationarySearcher7 searcher(range.start, range.end, 0, range.endFrame, { target }, profile7);
+                ReferenceSearcher<StationarySearcher7, Reference::SFMT, StationaryResult> reference(
+                    seed7, getStationaryKernel7(profile7, target), range.start, range.end, 0, range.endFrame,
+                    std::vector<StationaryTarget> { target }, profile7);
+                searcher.setOffsetDeltas(deltas);
+                reference.setOffsetDeltas(deltas);
+                match &= compareSearch("stationary7", searcher, reference, threads);
+            }
+            {
+                WildSearcher7 searcher(range.start, range.end, 0, range.endFrame, true, synchNature, type, 127, profile7,
+                                       getFilter<WildFilter>(30));
+                ReferenceSearcher<WildSearcher7, Reference::SFMT, WildResult> reference(
+                    seed7, getWildKernel7(profile7, true, synchNature, type, 127, getFilter<WildFilter>(30)), range.start, range.end, 0,
+                    range.endFrame, true, synchNature, type, 127, profile7, getFilter<WildFilter>(30));
+                match &= compareSearch("wild7", searcher, reference, threads);
+            }
+            {
+                EventSearcher7 searcher(range.start, range.end, 0, range.endFrame, event.ivCount, event.pidType, profile7,
+                                        getFilter<EventFilter>(30));
+                ReferenceSearcher<EventSearcher7, Reference::SFMT, EventResult> reference(
+                    seed7, getEventKernel7(profile7, event, getFilter<EventFilter>(30)), range.start, range.end, 0, range.endFrame,
+                    event.ivCount, event.pidType, profile7, getFilter<EventFilter>(30));
+                setupEvent(searcher, event);
+                setupEvent(reference, event);
+                match &= compareSearch("event7", searcher, reference, threads);
+            }
+            {
+                IDFilter filter("", "0\n1\n2", IDType::TID);
+                IDSearcher7 searcher(range.start, range.end, 0, range.endFrame, profile7, filter);
+                ReferenceSearcher<IDSearcher7, Reference::SFMT, IDResult> reference(seed7, getIDKernel7(filter), range.start, range.end, 0,
+                                                                                    range.endFrame, profile7, filter);
+                match &= compareSearch("id7", searcher, reference, threads);
+            }
+        }
+        return match;
+    }
+
+    // A cached search answers a tighter filter from its cache and a wider one by searching again with a widened filter,
+    // both have to find what a search without the cache finds
+    bool verifyCache(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 5, 29, 59);
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        std::vector<int> deltas = { -1, 0, 1 };
+
+        std::vector<bool> natures(25, false);
+        for (int i = 0; i < 5; i++)
+        {
+            natures[random() % 25] = true;
+        }
+        StationaryFilter tightened({ 28, 28, 28, 0, 0, 0 }, { 31, 31, 31, 31, 31, 31 }, natures, std::vector<bool>(16, true), 255, 255,
+                                   255);
+
+        struct Step
+        {
+            std::string name;
+            StationaryFilter filter;
+            bool cached;
+        };
+
+        auto cache = std::make_shared<ResultCache<StationaryResult>>();
+        bool match = true;
+        std::vector<Step> steps = { { "cache first", getFilter<StationaryFilter>(25), false },
+                                    { "cache tightened", tightened, true },
+                                    { "cache widened", getFilter<StationaryFilter>(20), false } };
+        for (const auto &step : steps)
+        {
+            StationarySearcher7 searcher(start, end, 0, 300, false, 255, 0, 127, false, false, profile, step.filter);
+            StationarySearcher7 reference(start, end, 0, 300, false, 255, 0, 127, false, false, profile, step.filter);
+            searcher.setOffsetDeltas(deltas);
+            reference.setOffsetDeltas(deltas);
+            searcher.setResultCache(cache);
+            match &= compareSearch(step.name, searcher, reference, threads);
+
+            // Only the tightened search can be answered without hashing any seeds
+            if (step.cached != (searcher.getStats().seeds == 0))
+            {
+                std::cerr << "  " << step.name << " hashed " << searcher.getStats().seeds << " seeds" << std::endl;
+                match &= report(step.name + " answered from the cache", 1, 1);
+            }
+        }
+        return match;
+    }
+
+    struct Window
+    {
+        DateTime start, end;
+        u32 startFrame, endFrame;
+    };
+
+    // The second search covers more seconds and frames than the first, only what the first didn't cover gets searched and
+    // both together have to find what searching the second window at once finds
+    template <class Make>
+    bool compareIncremental(const std::string &name, Make make, const Window &first, const Window &second, int threads)
+    {
+        auto coverage = std::make_shared<SearchCoverage>();
+        auto searcher = make(first);
+        searcher->setSearchCoverage(coverage);
+        bool incremental = searcher->isIncremental();
+        searcher->startSearch(threads);
+        auto results = searcher->getResults();
+
+        searcher = make(second);
+        searcher->setSearchCoverage(coverage);
+        incremental = !incremental && searcher->isIncremental();
+        searcher->startSearch(threads);
+        auto added = searcher->getResults();
+        results.insert(results.end(), added.begin(), added.end());
+
+        auto reference = make(second);
+        reference->startSearch(1);
+
+        auto lines = describe(results);
+        auto expected = describe(reference->getResults());
+        if (!incremental)
+        {
+            std::cerr << "  " << name << " searched the second window from scratch" << std::endl;
+        }
+        if (lines != expected)
+        {
+            std::cerr << "  " << name << " found " << lines.size() << " results, expected " << expected.size() << std::endl;
+        }
+        return report(name + " (" + std::to_string(expected.size()) + " results)", incremental && lines == expected ? 0 : 1, 1);
+    }
+
+    bool verifyIncremental(std::mt19937 &random, int threads)
+    {
+        u32 startFrame = 100 + random() % 100;
+        u32 earlierFrame = startFrame - random() % 100;
+        u32 laterFrame = 300 + random() % 200;
+        Window first = { DateTime(2021, 3, 4, 5, 10, 0), DateTime(2021, 3, 4, 5, 19, 59), startFrame, 300 };
+        Window second = { DateTime(2021, 3, 4, 5, 10 - random() % 10, 0), DateTime(2021, 3, 4, 5, 19 + random() % 10, 59), earlierFrame,
+                          laterFrame };
+
+        Profile7 profile7("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        auto make7 = [&](const Window &window) {
+            auto searcher = std::make_unique<StationarySearcher7>(window.start, window.end, window.startFrame, window.endFrame, false, 255,
+                                                                  0, 127, false, false, profile7, getFilter<StationaryFilter>(25));
+            searcher->setOffsetDeltas({ -1, 0, 1 });
+            return searcher;
+        };
+
+        Window first6 = { first.start, first.end, first.startFrame / 10, first.endFrame / 10 };
+        Window second6 = { second.start, second.end, second.startFrame / 10, second.endFrame / 10 };
+        Profile6 profile6("Verify", random(), random(), random() & 0xffff, random() & 0xffff, Game::X, false);
+        auto make6 = [&](const Window &window) {
+            return std::make_unique<StationarySearcher6>(window.start, window.end, window.startFrame, window.endFrame, false, 255, 0, 127,
+                                                         false, false, profile6, getFilter<StationaryFilter>(25));
+        };
+
+        bool match = true;
+        match &= compareIncremental("incremental stationary7", make7, first, second, threads);
+        match &= compareIncremental("incremental stationary6", make6, first6, second6, threads);
+        return match;
+    }
+
+    // Results only show their date as text
+    template <class ResultType>
+    DateTime getDateTime(const ResultType &result)
+    {
+        int year, month, day, hour, minute, second;
+        std::sscanf(result.getDateTime().c_str(), "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+        return DateTime(year, month, day, hour, minute, second);
+    }
+
+    template <class ResultType>
+    u64 getSeconds(const ResultType &result)
+    {
+        return Utility::getCitraTime(getDateTime(result), 0) / 1000;
+    }
+
+    // Ordered searches are compared line by line with the expected results in the order they're expected in
+    template <class ResultType>
+    bool compareOrdered(const std::string &name, const std::vector<ResultType> &results, const std::vector<ResultType> &expected)
+    {
+        auto lines = describe(results, false);
+        auto expectedLines = describe(expected, false);
+        if (lines != expectedLines)
+        {
+            std::cerr << "  " << name << " found " << lines.size() << " results, expected " << expectedLines.size() << std::endl;
+            for (size_t i = 0; i < std::min(lines.size(), expectedLines.size()); i++)
+            {
+                if (lines[i] != expectedLines[i])
+                {
+                    std::cerr << "  first difference at " << i << ": " << lines[i] << ", expected " << expectedLines[i] << std::endl;
+                    break;
+                }
+            }
+        }
+        return report(name + " (" + std::to_string(expected.size()) + " results)", lines == expectedLines ? 0 : 1, 1);
+    }
+
+    // A limited search keeps the earliest results by date, offset delta and frame, they have to be the first results of
+    // the unlimited search in that order
+    template <class Searcher>
+    bool compareLimit(const std::string &name, Searcher &limited, Searcher &reference, u32 limit, int threads)
+    {
+        limited.setResultLimit(limit);
+        limited.startSearch(threads);
+        reference.startSearch(1);
+
+        auto expected = reference.getResults();
+        std::sort(expected.begin(), expected.end(), [](const auto &left, const auto &right) {
+            return std::make_tuple(left.getDateTime(), left.getOffsetDelta(), left.getFrame())
+                < std::make_tuple(right.getDateTime(), right.getOffsetDelta(), right.getFrame());
+        });
+        expected.resize(std::min<size_t>(expected.size(), limit));
+        return compareOrdered(name, limited.getResults(), expected);
+    }
+
+    bool verifyResultLimit(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 6, 59, 59);
+        Profile7 profile7("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        Profile6 profile6("Verify", random(), random(), random() & 0xffff, random() & 0xffff, Game::X, false);
+
+        bool match = true;
+        for (u32 limit : { 1u, static_cast<u32>(2 + random() % 200) })
+        {
+            StationarySearcher7 limited(start, end, 0, 300, false, 255, 0, 127, false, false, profile7, getFilter<StationaryFilter>(28));
+            StationarySearcher7 reference(start, end, 0, 300, false, 255, 0, 127, false, false, profile7, getFilter<StationaryFilter>(28));
+            limited.setOffsetDeltas({ -1, 0, 1 });
+            reference.setOffsetDeltas({ -1, 0, 1 });
+            match &= compareLimit("result limit stationary7", limited, reference, limit, threads);
+        }
+        {
+            StationarySearcher6 limited(start, end, 0, 40, false, 255, 0, 127, false, false, profile6, getFilter<StationaryFilter>(25));
+            StationarySearcher6 reference(start, end, 0, 40, false, 255, 0, 127, false, false, profile6, getFilter<StationaryFilter>(25));
+            match &= compareLimit("result limit stationary6", limited, reference, 1 + random() % 50, threads);
+        }
+        return match;
+    }
+
+    // An anchored search finds the results within the radius of the anchor, closest seconds first and then by date,
+    // offset delta and frame, a limit keeps the closest of them
+    bool verifyAnchor(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 6, 59, 59);
+        DateTime anchor(2021, 3, 4, 4 + random() % 4, random() % 60, random() % 60);
+        u64 anchorSeconds = Utility::getCitraTime(anchor, 0) / 1000;
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+
+        struct Case
+        {
+            u64 radius;
+            u32 limit;
+        };
+
+        bool match = true;
+        for (const auto &test : { Case { 0, static_cast<u32>(1 + random() % 100) }, Case { 300 + random() % 1500, 0 },
+                                  Case { 300 + random() % 1500, static_cast<u32>(1 + random() % 20) } })
+        {
+            StationarySearcher7 anchored(start, end, 0, 300, false, 255, 0, 127, false, false, profile, getFilter<StationaryFilter>(28));
+            StationarySearcher7 reference(start, end, 0, 300, false, 255, 0, 127, false, false, profile, getFilter<StationaryFilter>(28));
+            anchored.setOffsetDeltas({ -1, 0, 1 });
+            reference.setOffsetDeltas({ -1, 0, 1 });
+            anchored.setAnchor(anchor, test.radius);
+            anchored.setResultLimit(test.limit);
+            anchored.startSearch(threads);
+            reference.startSearch(1);
+
+            auto distance = [anchorSeconds](const StationaryResult &result) {
+                u64 seconds = getSeconds(result);
+                return seconds > anchorSeconds ? seconds - anchorSeconds : anchorSeconds - seconds;
+            };
+
+            std::vector<StationaryResult> expected;
+            for (const auto &result : reference.getResults())
+            {
+                if (test.radius == 0 || distance(result) <= test.radius)
+                {
+                    expected.emplace_back(result);
+                }
+            }
+            std::sort(expected.begin(), expected.end(), [&distance](const auto &left, const auto &right) {
+                return std::make_tuple(distance(left), left.getDateTime(), left.getOffsetDelta(), left.getFrame())
+                    < std::make_tuple(distance(right), right.getDateTime(), right.getOffsetDelta(), right.getFrame());
+            });
+            if (test.limit != 0)
+            {
+                expected.resize(std::min<size_t>(expected.size(), test.limit));
+            }
+            match &= compareOrdered("anchor radius " + std::to_string(test.radius) + " limit " + std::to_string(test.limit),
+                                    anchored.getResults(), expected);
+        }
+        return match;
+    }
+
+    // A masked search only finds the results of the full search at the seconds its mask allows, checked here from the
+    // weekday and time of day of each result's date
+    bool verifyTimeMask(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 0, 0, 0);
+        DateTime end(2021, 3, 6, 23, 59, 59);
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+
+        StationarySearcher7 reference(start, end, 0, 30, false, 255, 0, 127, false, false, profile, getFilter<StationaryFilter>(31));
+        reference.startSearch(threads);
+        auto referenceResults = reference.getResults();
+
+        // Times of day that may wrap past midnight on random weekdays, at least one of the Thursday to Saturday searched,
+        // and an interval across midnight
+        u8 weekdays = (random() % 128) | (1 << (4 + random() % 3));
+        std::vector<std::pair<u32, u32>> times;
+        for (int i = 0; i < 2; i++)
+        {
+            u32 first = random() % 86400;
+            times.emplace_back(first, (first + 3600 + random() % 43200) % 86400);
+        }
+        DateTime intervalStart(2021, 3, 4, 20 + random() % 4, random() % 60, random() % 60);
+        DateTime intervalEnd(2021, 3, 5, random() % 4, random() % 60, random() % 60);
+
+        auto allowedTime = [&](const DateTime &date) {
+            if (((weekdays >> date.getDate().dayOfWeek()) & 1) == 0)
+            {
+                return false;
+            }
+            u32 second = date.getTime().hour() * 3600 + date.getTime().minute() * 60 + date.getTime().second();
+            return std::any_of(times.begin(), times.end(), [second](const auto &time) {
+                return time.first <= time.second ? second >= time.first && second < time.second
+                                                 : second >= time.first || second < time.second;
+            });
+        };
+        auto allowedInterval = [&](const DateTime &date) {
+            return date.toMSecsSinceEpoch() >= intervalStart.toMSecsSinceEpoch()
+                && date.toMSecsSinceEpoch() <= intervalEnd.toMSecsSinceEpoch();
+        };
+
+        bool match = true;
+        for (bool interval : { false, true })
+        {
+            TimeMask mask;
+            if (interval)
+            {
+                mask.addInterval(intervalStart, intervalEnd);
+            }
+            else
+            {
+                mask.setWeekdays(weekdays);
+                for (const auto &[first, last] : times)
+                {
+                    mask.addTime(first, last);
+                }
+            }
+
+            StationarySearcher7 masked(start, end, 0, 30, false, 255, 0, 127, false, false, profile, getFilter<StationaryFilter>(31));
+            masked.setTimeMask(mask);
+            masked.startSearch(threads);
+
+            std::vector<StationaryResult> expected;
+            for (const auto &result : referenceResults)
+            {
+                DateTime date = getDateTime(result);
+                if (interval ? allowedInterval(date) : allowedTime(date))
+                {
+                    expected.emplace_back(result);
+                }
+            }
+
+            auto results = describe(masked.getResults());
+            auto expectedLines = describe(expected);
+            std::string name = interval ? "time mask interval" : "time mask times of day";
+            if (results != expectedLines)
+            {
+                std::cerr << "  " << name << " found " << results.size() << " results, expected " << expectedLines.size() << std::endl;
+            }
+            match &= report(name + " (" + std::to_string(expected.size()) + " results)", results == expectedLines ? 0 : 1, 1);
+        }
+        return match;
+    }
+
+    // A batched job keeps its own results, they have to be what the job finds when searched alone
+    template <class Searcher>
+    bool compareJob(const std::string &name, Searcher &job, Searcher &alone, int threads)
+    {
+        alone.startSearch(threads);
+
+        auto results = describe(job.getResults());
+        auto expected = describe(alone.getResults());
+        if (results != expected)
+        {
+            std::cerr << "  " << name << " found " << results.size() << " results, expected " << expected.size() << std::endl;
+        }
+        return report(name + " (" + std::to_string(expected.size()) + " results)", results == expected ? 0 : 1, 1);
+    }
+
+    bool compareGroups(const std::string &name, size_t groups, size_t expected)
+    {
+        if (groups != expected)
+        {
+            std::cerr << "  " << name << " formed " << groups << " groups, expected " << expected << std::endl;
+        }
+        return report(name + " groups", groups == expected ? 0 : 1, 1);
+    }
+
+    // Jobs of each generation with overlapping frame ranges, which share a group, and one far from the others, which
+    // gets a group of its own
+    bool verifyBatch(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 5, 19, 59);
+        Profile6 profile6("Verify", random(), random(), random() & 0xffff, random() & 0xffff, Game::X, false);
+        Profile7 profile7("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        std::vector<int> deltas = { -1, 0, 1 };
+        u8 synchNature = random() % 25;
+        IDFilter idFilter("", "0\n1\n2", IDType::TID);
+
+        bool match = true;
+        {
+            auto stationary = [&](u32 startFrame, u32 endFrame, bool alwaysSynch) {
+                return std::make_unique<StationarySearcher6>(start, end, startFrame, endFrame, false, 255, synchNature, 127, alwaysSynch,
+                                                             false, profile6, getFilter<StationaryFilter>(25));
+            };
+            auto first = stationary(0, 40, false);
+            auto firstAlone = stationary(0, 40, false);
+            auto second = stationary(30, 80, true);
+            auto secondAlone = stationary(30, 80, true);
+            auto far = stationary(5000, 5040, false);
+            auto farAlone = stationary(5000, 5040, false);
+
+            BatchSearcher<u32, MT> batch;
+            batch.addJob(first.get());
+            batch.addJob(second.get());
+            batch.addJob(far.get());
+            batch.startSearch(threads);
+
+            match &= compareGroups("batch6", batch.getGroupCount(), 2);
+            match &= compareJob("batch6 stationary", *first, *firstAlone, threads);
+            match &= compareJob("batch6 stationary synch", *second, *secondAlone, threads);
+            match &= compareJob("batch6 stationary far", *far, *farAlone, threads);
+        }
+        {
+            auto stationary = [&](u32 startFrame, u32 endFrame, bool alwaysSynch) {
+                auto searcher = std::make_unique<StationarySearcher7>(start, end, startFrame, endFrame, false, 255, synchNature, 127,
+                                                                      alwaysSynch, false, profile7, getFilter<StationaryFilter>(28));
+                searcher->setOffsetDeltas(deltas);
+                return searcher;
+            };
+            auto id = [&](u32 startFrame, u32 endFrame) {
+                auto searcher = std::make_unique<IDSearcher7>(start, end, startFrame, endFrame, profile7, idFilter);
+                searcher->setOffsetDeltas(deltas);
+                return searcher;
+            };
+            auto first = stationary(0, 300, false);
+            auto firstAlone = stationary(0, 300, false);
+            auto second = stationary(250, 600, true);
+            auto secondAlone = stationary(250, 600, true);
+            auto third = id(500, 2000);
+            auto thirdAlone = id(500, 2000);
+            auto far = stationary(100000, 100300, false);
+            auto farAlone = stationary(100000, 100300, false);
+
+            BatchSearcher<u64, SFMT> batch;
+            batch.addJob(first.get());
+            batch.addJob(second.get());
+            batch.addJob(third.get());
+            batch.addJob(far.get());
+            batch.startSearch(threads);
+
+            match &= compareGroups("batch7", batch.getGroupCount(), 2);
+            match &= compareJob("batch7 stationary", *first, *firstAlone, threads);
+            match &= compareJob("batch7 stationary synch", *second, *secondAlone, threads);
+            match &= compareJob("batch7 id", *third, *thirdAlone, threads);
+            match &= compareJob("batch7 stationary far", *far, *farAlone, threads);
+        }
+        return match;
+    }
+
+    // A search for several targets marks each result with the index of its target, the results of each target have to be
+    // what searching for that target alone finds
+    template <class Searcher, class Profile>
+    bool compareTargets(const std::string &name, const std::vector<StationaryTarget> &targets, const Profile &profile, u32 endFrame,
+                        int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 5, 19, 59);
+
+        Searcher searcher(start, end, 0, endFrame, targets, profile);
+        searcher.startSearch(threads);
+        auto results = searcher.getResults();
+
+        bool match = true;
+        for (size_t i = 0; i < targets.size(); i++)
+        {
+            Searcher alone(start, end, 0, endFrame, std::vector<StationaryTarget> { targets[i] }, profile);
+            alone.startSearch(threads);
+
+            std::vector<StationaryResult> found;
+            std::copy_if(results.begin(), results.end(), std::back_inserter(found),
+                         [i](const StationaryResult &result) { return result.getEncounter() == i; });
+
+            auto lines = describe(found);
+            auto expected = describe(alone.getResults());
+            std::string targetName = name + " target " + std::to_string(i);
+            if (lines != expected)
+            {
+                std::cerr << "  " << targetName << " found " << lines.size() << " results, expected " << expected.size() << std::endl;
+            }
+            match &= report(targetName + " (" + std::to_string(expected.size()) + " results)", lines == expected ? 0 : 1, 1);
+        }
+
+        size_t unknown = std::count_if(results.begin(), results.end(),
+                                       [&targets](const StationaryResult &result) { return result.getEncounter() >= targets.size(); });
+        if (unknown != 0)
+        {
+            std::cerr << "  " << name << " found " << unknown << " results of unknown targets" << std::endl;
+        }
+        return report(name + " encounters", unknown == 0 ? 0 : 1, 1) && match;
+    }
+
+    bool verifyTargets(std::mt19937 &random, int threads)
+    {
+        Profile6 profile6("Verify", random(), random(), random() & 0xffff, random() & 0xffff, Game::X, false);
+        Profile7 profile7("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+
+        // Targets that read different numbers of values per frame
+        std::vector<StationaryTarget> targets;
+        for (int i = 0; i < 3; i++)
+        {
+            targets.emplace_back(random() % 2 == 0, 255, random() % 25, 127, random() % 2 == 0, random() % 2 == 0,
+                                 getFilter<StationaryFilter>(28 + random() % 3));
+        }
+
+        bool match = true;
+        match &= compareTargets<StationarySearcher6>("targets6", targets, profile6, 40, threads);
+        match &= compareTargets<StationarySearcher7>("targets7", targets, profile7, 400, threads);
+        return match;
+    }
+
+    // Hits of an hour often share their best frame, the best hit of each bucket has to be the same however the workers
+    // merged their histograms
+    bool verifyHistogram(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 8, 59, 59);
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        std::vector<int> deltas = { -2, -1, 0, 1, 2 };
+
+        auto search = [&](int workers) {
+            auto histogram = std::make_shared<SearchHistogram>();
+            StationarySearcher7 searcher(start, end, 0, 20, false, 255, 0, 127, false, false, profile, getFilter<StationaryFilter>(20));
+            searcher.setOffsetDeltas(deltas);
+            searcher.setHistogram(histogram);
+            searcher.startSearch(workers);
+            return histogram;
+        };
+
+        auto results = describe(*search(threads));
+        auto expected = describe(*search(1));
+        if (results != expected)
+        {
+            std::cerr << "  histogram differs from the single threaded search" << std::endl;
+        }
+        return report("histogram (" + std::to_string(expected.size()) + " hours)", results == expected ? 0 : 1, 1);
+    }
+
+    // A search interrupted halfway has to resume from its journal even when a result cache widens the filter it searches
+    // with, and then find what an uninterrupted search finds
+    bool verifyJournal(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 5, 0, 0);
+        DateTime end(2021, 3, 4, 6, 59, 59);
+        u32 seconds = 7200;
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+
+        std::vector<bool> natures(25, false);
+        for (int i = 0; i < 5; i++)
+        {
+            natures[random() % 25] = true;
+        }
+        StationaryFilter filter({ 25, 25, 25, 0, 0, 0 }, { 31, 31, 31, 31, 31, 31 }, natures, std::vector<bool>(16, true), 255, 255, 255);
+
+        std::string name = "3DSTimeFinderVerify" + std::to_string(random()) + ".journal";
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        auto cache = std::make_shared<ResultCache<StationaryResult>>();
+
+        StationarySearcher7 interrupted(start, end, 0, 200, false, 255, 0, 127, false, false, profile, filter);
+        interrupted.setResultCache(cache);
+        interrupted.setJournalPath(path);
+        interrupted.setResultCallback([&interrupted, seconds](const std::vector<StationaryResult> &) {
+            if (interrupted.getProgress() >= seconds / 2)
+            {
+                interrupted.cancelSearch();
+            }
+        });
+        interrupted.startSearch(1);
+
+        StationarySearcher7 resumed(start, end, 0, 200, false, 255, 0, 127, false, false, profile, filter);
+        resumed.setResultCache(cache);
+        resumed.setJournalPath(path);
+        resumed.startSearch(threads);
+
+        StationarySearcher7 reference(start, end, 0, 200, false, 255, 0, 127, false, false, profile, filter);
+        reference.startSearch(threads);
+
+        auto results = describe(resumed.getResults());
+        auto expected = describe(reference.getResults());
+        u64 seeds = resumed.getStats().seeds;
+        std::filesystem::remove(path);
+
+        if (seeds >= seconds)
+        {
+            std::cerr << "  journal resumed search hashed " << seeds << " of " << seconds << " seeds" << std::endl;
+        }
+        if (results != expected)
+        {
+            std::cerr << "  journal resumed search found " << results.size() << " results, expected " << expected.size() << std::endl;
+        }
+        return report("journal (" + std::to_string(expected.size()) + " results)", seeds < seconds && results == expected ? 0 : 1, 1);
+    }
+
+    // Seeds planted among random ones have to be found at the seconds they were hashed from, and every date found has to
+    // hash to the seed reported for it
+    bool verifySeedDates(std::mt19937 &random, int threads)
+    {
+        DateTime start(2021, 3, 4, 0, 0, 0);
+        DateTime end(2021, 3, 5, 23, 59, 59);
+        u32 seconds = 172800;
+        Profile7 profile("Verify", random() % 100, random(), random() & 0xffff, random() & 0xffff, Game::UltraSun, false);
+        u64 epochStart = Utility::getCitraTime(start, profile.getOffset());
+
+        std::vector<u32> wantedSeeds;
+        std::vector<std::string> planted;
+        for (int i = 0; i < 20; i++)
+        {
+            u32 second = random() % seconds;
+            u32 seed = Reference::calcInitialSeed(profile.getTick(), epochStart + second * 1000ull);
+            DateTime date = start;
+            date.addSeconds(second);
+
+            wantedSeeds.emplace_back(seed);
+            planted.emplace_back(date.toString() + " " + std::to_string(seed));
+        }
+        for (int i = 0; i < 5000; i++)
+        {
+            wantedSeeds.emplace_back(random());
+        }
+        std::shuffle(wantedSeeds.begin(), wantedSeeds.end(), random);
+
+        SeedDateFinder7 finder(start, end, profile, wantedSeeds);
+        finder.startSearch(threads);
+
+        int mismatches = 0;
+        std::vector<std::string> found;
+        for (const auto &[date, seed] : finder.getResults())
+        {
+            u32 expected = Reference::calcInitialSeed(profile.getTick(), Utility::getCitraTime(date, profile.getOffset()));
+            if (seed != expected || std::find(wantedSeeds.begin(), wantedSeeds.end(), seed) == wantedSeeds.end())
+            {
+                std::cerr << "  seed dates found " << date.toString() << " for seed " << seed << " that isn't wanted there" << std::endl;
+                mismatches++;
+            }
+            found.emplace_back(date.toString() + " " + std::to_string(seed));
+        }
+
+        for (const auto &line : planted)
+        {
+            if (std::find(found.begin(), found.end(), line) == found.end())
+            {
+                std::cerr << "  seed dates missed " << line << std::endl;
+                mismatches++;
+            }
+        }
+        if (finder.getProgress() != finder.getMaxProgress() || finder.getMaxProgress() != seconds)
+        {
+            std::cerr << "  seed dates progress " << finder.getProgress() << " of " << finder.getMaxProgress() << std::endl;
+            mismatches++;
+        }
+        return report("seed dates (" + std::to_string(found.size()) + " found)", mismatches, static_cast<int>(planted.size()) + 1);
+    }
+}
+
+namespace Verify
+{
+    bool run(u32 seed, int iterations, int threads)
+    {
+        std::cerr << "Verifying " << getISA() << " kernels with seed " << seed << std::endl;
+
+        std::mt19937 random(seed);
+        bool match = verifySFMT(random, iterations);
+        match &= verifyMT(random, iterations);
+        match &= verifyHash(random, iterations * 10);
+        match &= verifySearchers(random, threads);
+        match &= verifyCache(random, threads);
+        match &= verifyIncremental(random, threads);
+        match &= verifyResultLimit(random, threads);
+        match &= verifyAnchor(random, threads);
+        match &= verifyTimeMask(random, threads);
+        match &= verifyBatch(random, threads);
+        match &= verifyTargets(random, threads);
+        match &= verifyJournal(random, threads);
+        match &= verifyHistogram(random, threads);
+        match &= verifySeedDates(random, threads);
+        return match;
+    }
+}
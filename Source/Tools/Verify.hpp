@@ -0,0 +1,35 @@
+/*
+ * This file is part of 3DSTimeFinder
+ * Copyright (C) 2019-2024 by Admiral_Fish
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include <Core/Util/Global.hpp>
+
+namespace Verify
+{
+    // Checks the optimized RNGs, seed hashes and searchers against the scalar reference implementations over
+    // randomized seeds and frame offsets, that cached, incremental, limited, anchored, masked, batched and multi-target
+    // searches find what a full search finds, that an interrupted search resumes from its journal, that hit histograms
+    // don't depend on the thread count and that planted seeds are dated. Mismatches are printed, returns true when
+    // everything matches.
+    bool run(u32 seed, int iterations, int threads);
+}
+
+#endif // VERIFY_HPP